@@ -30,12 +30,23 @@
 
 #include <array>
 #include <cstdio>
+#include <memory>
 #include <vector>
 
 #include "glk.h"
 #include "garglk.h"
 #include "gi_blorb.h"
 
+#ifdef GARGLK
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#endif
+
 /* We'd like to be able to deal with game files in Blorb files, even
    if we never load a sound or image. We'd also like to be able to
    deal with Data chunks. So we're willing to set a map here. */
@@ -44,6 +55,61 @@ static giblorb_map_t *blorbmap = 0; /* NULL */
 
 #ifdef GARGLK
 static strid_t blorbfile = nullptr;
+
+// The Blorb file, if it could be memory-mapped. Resource spans share
+// ownership of the mapping, so it outlives the map if they need it to.
+static std::shared_ptr<const unsigned char> blorbdata;
+static glui32 blorblength;
+
+static std::shared_ptr<const unsigned char> map_blorb_file(std::FILE *fp, glui32 &length)
+{
+#ifdef _WIN32
+    auto fh = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(fp)));
+    LARGE_INTEGER size;
+
+    if (fh == INVALID_HANDLE_VALUE || !GetFileSizeEx(fh, &size) ||
+        size.QuadPart == 0 || size.QuadPart > 0xffffffff) {
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMapping(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    // The view keeps the mapping object alive.
+    void *p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (p == nullptr) {
+        return nullptr;
+    }
+
+    length = size.QuadPart;
+
+    return std::shared_ptr<const unsigned char>(static_cast<const unsigned char *>(p), [](const unsigned char *p) {
+        UnmapViewOfFile(p);
+    });
+#else
+    struct stat st;
+
+    if (fstat(fileno(fp), &st) != 0 || !S_ISREG(st.st_mode) ||
+        st.st_size == 0 || st.st_size > 0xffffffff) {
+        return nullptr;
+    }
+
+    std::size_t size = st.st_size;
+    void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+    if (p == MAP_FAILED) {
+        return nullptr;
+    }
+
+    length = size;
+
+    return std::shared_ptr<const unsigned char>(static_cast<const unsigned char *>(p), [size](const unsigned char *p) {
+        munmap(const_cast<unsigned char *>(p), size);
+    });
+#endif
+}
 #endif
 
 giblorb_err_t giblorb_set_resource_map(strid_t file)
@@ -68,6 +134,9 @@ giblorb_err_t giblorb_set_resource_map(strid_t file)
       glk_stream_close(blorbfile, nullptr);
       blorbfile = nullptr;
   }
+
+  blorbdata.reset();
+  blorblength = 0;
 #endif
 
   err = giblorb_create_map(file, &blorbmap);
@@ -78,6 +147,15 @@ giblorb_err_t giblorb_set_resource_map(strid_t file)
   
 #ifdef GARGLK
   blorbfile = file;
+
+  if (file->type == strtype_File) {
+      blorbdata = map_blorb_file(file->file, blorblength);
+      if (blorbdata != nullptr) {
+          giblorb_set_map_data(blorbmap, blorbdata.get(), blorblength);
+      }
+  } else {
+      giblorb_set_map_data(blorbmap, file->buf, file->buflen);
+  }
 #endif
 
   return giblorb_err_None;
@@ -89,7 +167,9 @@ giblorb_map_t *giblorb_get_resource_map()
 }
 
 #ifdef GARGLK
-bool giblorb_copy_resource(glui32 usage, glui32 resnum, glui32 &type, std::vector<unsigned char> &buf)
+// Get a resource from the Blorb file without copying it, if the file is
+// memory-mapped; otherwise it's read into a buffer owned by the span.
+bool giblorb_get_resource_span(glui32 usage, glui32 resnum, glui32 &type, garglk::ByteSpan &span)
 {
     if (blorbmap == nullptr) {
         return false;
@@ -104,6 +184,15 @@ bool giblorb_copy_resource(glui32 usage, glui32 resnum, glui32 &type, std::vecto
     auto pos = blorbres.data.startpos;
     auto len = blorbres.length;
 
+    type = blorbres.chunktype;
+
+    if (blorbdata != nullptr && pos + len <= blorblength) {
+        span = garglk::ByteSpan(blorbdata.get() + pos, len, blorbdata);
+        return true;
+    }
+
+    std::vector<unsigned char> buf;
+
     try {
         buf.resize(len);
     } catch (const std::bad_alloc &) {
@@ -124,7 +213,7 @@ bool giblorb_copy_resource(glui32 usage, glui32 resnum, glui32 &type, std::vecto
         return false;
     }
 
-    type = blorbres.chunktype;
+    span = garglk::ByteSpan(std::move(buf));
 
     return true;
 }
@@ -78,6 +78,10 @@ struct giblorb_map_struct {
         in map->resources -- sorted by usage and resource number. */
 
     giblorb_auxpict_t *auxpict;
+
+    const unsigned char *data; /* the whole file, if it's in memory 
+        (see giblorb_set_map_data()); NULL otherwise */
+    glui32 datalength;
 };
 
 #define giblorb_Inited_Magic (0xB7012BED) 
@@ -214,6 +218,8 @@ giblorb_err_t giblorb_create_map(strid_t file, giblorb_map_t **newmap)
     map->palette = NULL;
     map->auxsound = NULL;*/
     map->auxpict = NULL;
+    map->data = NULL;
+    map->datalength = 0;
     
     /* Now we do everything else involved in loading the Blorb file,
         such as building resource lists. */
@@ -443,6 +449,13 @@ giblorb_err_t giblorb_load_chunk_by_number(giblorb_map_t *map,
             break;
             
         case giblorb_method_Memory:
+            if (!chu->ptr && map->data 
+                && chu->datpos + chu->len <= map->datalength) {
+                /* Hand out the data in place; there's nothing to 
+                    unload. */
+                res->data.ptr = (void *)(map->data + chu->datpos);
+                break;
+            }
             if (!chu->ptr) {
                 glui32 readlen;
                 void *dat = giblorb_malloc(chu->len);
@@ -488,6 +501,22 @@ giblorb_err_t giblorb_load_resource(giblorb_map_t *map, glui32 method,
     return giblorb_load_chunk_by_number(map, method, res, found->chunknum);
 }
 
+giblorb_err_t giblorb_set_map_data(giblorb_map_t *map, 
+    const unsigned char *data, glui32 length)
+{
+    if (!map || map->inited != giblorb_Inited_Magic)
+        return giblorb_err_NotAMap;
+
+    map->data = data;
+    map->datalength = data ? length : 0;
+    return giblorb_err_None;
+}
+
+int giblorb_is_mapped(giblorb_map_t *map)
+{
+    return (map && map->inited == giblorb_Inited_Magic && map->data);
+}
+
 giblorb_err_t giblorb_unload_chunk(giblorb_map_t *map, glui32 chunknum)
 {
     giblorb_chunkdesc_t *chu;
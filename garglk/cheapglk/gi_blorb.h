@@ -92,6 +92,18 @@ extern giblorb_err_t giblorb_count_resources(giblorb_map_t *map,
 extern giblorb_err_t giblorb_load_image_info(giblorb_map_t *map,
     glui32 resnum, giblorb_image_info_t *res);
 
+#ifdef GARGLK
+/* Gargoyle extension: if the whole Blorb file is in memory (Gargoyle 
+    memory-maps the resource map's file when it can), chunks loaded 
+    with giblorb_method_Memory point straight into it. Nothing is read 
+    or allocated, giblorb_unload_chunk() is a no-op, and the data must 
+    be treated as read-only. It stays valid for as long as the map. 
+    giblorb_is_mapped() tells whether a map works this way. */
+extern giblorb_err_t giblorb_set_map_data(giblorb_map_t *map, 
+    const unsigned char *data, glui32 length);
+extern int giblorb_is_mapped(giblorb_map_t *map);
+#endif
+
 /* The following functions are part of the Glk library itself, not 
     the Blorb layer (whose code is in gi_blorb.c). These functions 
     are necessarily implemented in platform-dependent code. 
@@ -503,6 +503,10 @@ extern void garglk_set_program_info(const char *info);
 extern void garglk_set_story_name(const char *name);
 extern void garglk_set_story_title(const char *title);
 
+/* garglk_decrunch_cache_directory - returns the directory configured for
+ * caching decrunched C64 images, or NULL if caching is disabled. */
+extern const char *garglk_decrunch_cache_directory(void);
+
 /* garglk_unput_string - removes the specified string from the end of the output buffer, if
  * indeed it is there. */
 extern void garglk_unput_string(const char *str);
@@ -240,6 +240,8 @@ bool gli_conf_per_game_config = true;
 
 bool gli_conf_dedicated_save_directory = false;
 
+std::string gli_conf_decrunch_cache_directory;
+
 Scaler gli_conf_scaler = Scaler::None;
 
 std::string garglk::downcase(const std::string &string)
@@ -852,6 +854,8 @@ static void readoneconfig(const std::string &fname, const std::string &argv0, co
                 gli_conf_per_game_config = asbool(arg);
             } else if (cmd == "dedicated_save_directory") {
                 gli_conf_dedicated_save_directory = asbool(arg);
+            } else if (cmd == "decrunch_cache_directory") {
+                gli_conf_decrunch_cache_directory = arg;
             } else if (cmd == "redraw_hack") {
                 gli_conf_redraw_hack = asbool(arg);
             } else if (cmd == "glyph_substitution_file") {
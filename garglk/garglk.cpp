@@ -64,6 +64,15 @@ void garglk_set_story_title(const char *title)
     wintitle();
 }
 
+const char *garglk_decrunch_cache_directory()
+{
+    if (gli_conf_decrunch_cache_directory.empty()) {
+        return nullptr;
+    }
+
+    return gli_conf_decrunch_cache_directory.c_str();
+}
+
 int garglk_tads_os_banner_size(winid_t win)
 {
     window_textbuffer_t *dwin = win->winbuffer();
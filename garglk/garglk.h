@@ -186,6 +186,59 @@ std::unique_ptr<T, Deleter> unique(T *p, Deleter deleter)
 
 bool read_file(const std::string &filename, std::vector<unsigned char> &buf);
 
+// A read-only view of a block of bytes, such as an image or sound
+// resource. When the bytes belong to something that could otherwise
+// go away (a memory-mapped Blorb file, or a buffer read just for this
+// view), the view shares ownership of it, so, for example, a sound
+// keeps playing even if the Blorb map it came from is replaced.
+class ByteSpan {
+public:
+    ByteSpan() = default;
+
+    ByteSpan(const unsigned char *data, std::size_t size, std::shared_ptr<const void> owner = nullptr) :
+        m_owner(std::move(owner)),
+        m_data(data),
+        m_size(size)
+    {
+    }
+
+    explicit ByteSpan(std::vector<unsigned char> buf) {
+        auto owned = std::make_shared<const std::vector<unsigned char>>(std::move(buf));
+        m_data = owned->data();
+        m_size = owned->size();
+        m_owner = std::move(owned);
+    }
+
+    const unsigned char *data() const {
+        return m_data;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    const unsigned char *begin() const {
+        return m_data;
+    }
+
+    const unsigned char *end() const {
+        return m_data + m_size;
+    }
+
+    const unsigned char &operator[](std::size_t i) const {
+        return m_data[i];
+    }
+
+private:
+    std::shared_ptr<const void> m_owner;
+    const unsigned char *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
 template <typename Iterable, typename DType>
 std::string join(const Iterable &values, const DType &delim)
 {
@@ -669,6 +722,8 @@ extern bool gli_conf_per_game_config;
 
 extern bool gli_conf_dedicated_save_directory;
 
+extern std::string gli_conf_decrunch_cache_directory;
+
 enum class Scaler {
     None,
     HQX,
@@ -1126,7 +1181,7 @@ void winclipstore(const glui32 *text, int len);
 void fontload();
 void fontunload();
 
-bool giblorb_copy_resource(glui32 usage, glui32 resnum, glui32 &type, std::vector<unsigned char> &buf);
+bool giblorb_get_resource_span(glui32 usage, glui32 resnum, glui32 &type, garglk::ByteSpan &span);
 
 std::shared_ptr<picture_t> gli_picture_load(unsigned long id);
 void gli_picture_store(const std::shared_ptr<picture_t> &pic);
@@ -45,8 +45,8 @@ using std::FILE;
 #include "garglk.h"
 #include "gi_blorb.h"
 
-static std::shared_ptr<picture_t> load_image_png(const std::vector<unsigned char> &buf, unsigned long id);
-static std::shared_ptr<picture_t> load_image_jpeg(const std::vector<unsigned char> &buf, unsigned long id);
+static std::shared_ptr<picture_t> load_image_png(const garglk::ByteSpan &buf, unsigned long id);
+static std::shared_ptr<picture_t> load_image_jpeg(const garglk::ByteSpan &buf, unsigned long id);
 
 namespace {
 
@@ -124,26 +124,31 @@ std::shared_ptr<picture_t> gli_picture_load(unsigned long id)
         return pic;
     }
 
-    std::vector<unsigned char> buf;
+    garglk::ByteSpan buf;
 
     if (giblorb_get_resource_map() != nullptr) {
-        if (!giblorb_copy_resource(giblorb_ID_Pict, id, chunktype, buf)) {
+        if (!giblorb_get_resource_span(giblorb_ID_Pict, id, chunktype, buf)) {
             return nullptr;
         }
     } else {
         const auto &resource_map = gli_get_resource_map(giblorb_ID_Pict);
         if (!resource_map.empty()) {
             try {
-                buf = resource_map.at(id);
+                // Resources added from files live as long as Gargoyle does.
+                const auto &resource = resource_map.at(id);
+                buf = garglk::ByteSpan(resource.data(), resource.size());
             } catch (const std::out_of_range &) {
                 return nullptr;
             }
         } else {
             auto filename = Format("{}/PIC{}", gli_workdir, id);
+            std::vector<unsigned char> data;
 
-            if (!garglk::read_file(filename, buf)) {
+            if (!garglk::read_file(filename, data)) {
                 return nullptr;
             }
+
+            buf = garglk::ByteSpan(std::move(data));
         }
 
         if (buf.size() < 8) {
@@ -160,7 +165,7 @@ std::shared_ptr<picture_t> gli_picture_load(unsigned long id)
         }
     }
 
-    const std::unordered_map<int, std::function<std::shared_ptr<picture_t>(const std::vector<unsigned char> &, unsigned long)>> loaders = {
+    const std::unordered_map<int, std::function<std::shared_ptr<picture_t>(const garglk::ByteSpan &, unsigned long)>> loaders = {
         {giblorb_ID_PNG, load_image_png},
         {giblorb_ID_JPEG, load_image_jpeg},
     };
@@ -179,7 +184,7 @@ std::shared_ptr<picture_t> gli_picture_load(unsigned long id)
     return nullptr;
 }
 
-static std::shared_ptr<picture_t> load_image_jpeg(const std::vector<unsigned char> &buf, unsigned long id)
+static std::shared_ptr<picture_t> load_image_jpeg(const garglk::ByteSpan &buf, unsigned long id)
 {
 #ifdef GARGLK_CONFIG_JPEG_TURBO
     auto tj = garglk::unique(tjInitDecompress(), tjDestroy);
@@ -272,7 +277,7 @@ static std::shared_ptr<picture_t> load_image_jpeg(const std::vector<unsigned cha
 #endif
 }
 
-static std::shared_ptr<picture_t> load_image_png(const std::vector<unsigned char> &buf, unsigned long id)
+static std::shared_ptr<picture_t> load_image_png(const garglk::ByteSpan &buf, unsigned long id)
 {
     png_image image;
 
@@ -94,7 +94,7 @@ namespace {
 
 class VFS {
 public:
-    explicit VFS(std::vector<unsigned char> buf) : m_buf(std::move(buf)) {
+    explicit VFS(garglk::ByteSpan buf) : m_buf(std::move(buf)) {
     }
 
     qsizetype size() {
@@ -149,7 +149,7 @@ public:
     }
 
 private:
-    const std::vector<unsigned char> m_buf;
+    const garglk::ByteSpan m_buf;
     off_t m_offset = 0;
 };
 
@@ -247,7 +247,7 @@ private:
 // C++17, use the C API.
 class OpenMPTSource : public SoundSource {
 public:
-    OpenMPTSource(const std::vector<unsigned char> &buf, int plays) :
+    OpenMPTSource(const garglk::ByteSpan &buf, int plays) :
         SoundSource(plays),
         m_mod(openmpt_module_create_from_memory2(buf.data(), buf.size(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr), openmpt_module_destroy)
     {
@@ -273,7 +273,7 @@ private:
 
 class SndfileSource : public SoundSource {
 public:
-    SndfileSource(std::vector<unsigned char> buf, glui32 plays) :
+    SndfileSource(garglk::ByteSpan buf, glui32 plays) :
         SoundSource(plays),
         m_vfs(std::move(buf))
     {
@@ -339,7 +339,7 @@ private:
 
 class Mpg123Source : public SoundSource {
 public:
-    Mpg123Source(std::vector<unsigned char> buf, glui32 plays) :
+    Mpg123Source(garglk::ByteSpan buf, glui32 plays) :
         SoundSource(plays),
 #if MPG123_API_VERSION < 46
         m_handle(nullptr, mpg123_delete),
@@ -440,7 +440,7 @@ private:
 #ifdef GARGLK_HAS_FLUIDSYNTH
 class FluidSynthSource : public SoundSource {
 public:
-    FluidSynthSource(const std::vector<unsigned char> &buf, glui32 plays) :
+    FluidSynthSource(const garglk::ByteSpan &buf, glui32 plays) :
         SoundSource(plays)
     {
         for (const auto &level : {FLUID_PANIC, FLUID_ERR, FLUID_WARN, FLUID_INFO, FLUID_DBG}) {
@@ -789,11 +789,11 @@ void glk_schannel_set_volume_ext(schanid_t chan, glui32 vol, glui32 duration, gl
     chan->last_volume_bump = std::chrono::steady_clock::now();
 }
 
-static int detect_format(const std::vector<unsigned char> &data)
+static int detect_format(const garglk::ByteSpan &data)
 {
     struct Magic {
         virtual ~Magic() = default;
-        virtual bool matches(const std::vector<unsigned char> &data) const = 0;
+        virtual bool matches(const garglk::ByteSpan &data) const = 0;
     };
 
     struct MagicString : public Magic {
@@ -803,7 +803,7 @@ static int detect_format(const std::vector<unsigned char> &data)
         {
         }
 
-        bool matches(const std::vector<unsigned char> &data) const override {
+        bool matches(const garglk::ByteSpan &data) const override {
             if (m_offset + m_string.size() > data.size()) {
                 return false;
             }
@@ -817,7 +817,7 @@ static int detect_format(const std::vector<unsigned char> &data)
     };
 
     struct MagicMod : public Magic {
-        bool matches(const std::vector<unsigned char> &data) const override {
+        bool matches(const garglk::ByteSpan &data) const override {
             std::size_t size = std::min(openmpt_probe_file_header_get_recommended_size(), static_cast<std::size_t>(data.size()));
 
             return openmpt_probe_file_header(OPENMPT_PROBE_FILE_HEADER_FLAGS_DEFAULT,
@@ -861,24 +861,24 @@ static int detect_format(const std::vector<unsigned char> &data)
     throw SoundError("no matching magic");
 }
 
-static std::pair<int, std::vector<unsigned char>> load_bleep_resource(glui32 snd)
+static std::pair<int, garglk::ByteSpan> load_bleep_resource(glui32 snd)
 {
     if (snd != 1 && snd != 2) {
         throw SoundError("invalid bleep selected");
     }
 
-    auto data = gli_bleeps.at(snd);
+    garglk::ByteSpan data(gli_bleeps.at(snd));
     return {detect_format(data), data};
 }
 
-static std::pair<int, std::vector<unsigned char>> load_sound_resource(glui32 snd)
+static std::pair<int, garglk::ByteSpan> load_sound_resource(glui32 snd)
 {
-    std::vector<unsigned char> data;
+    garglk::ByteSpan data;
 
     if (giblorb_get_resource_map() != nullptr) {
         glui32 type;
 
-        if (!giblorb_copy_resource(giblorb_ID_Snd, snd, type, data)) {
+        if (!giblorb_get_resource_span(giblorb_ID_Snd, snd, type, data)) {
             throw SoundError("can't get blorb resource");
         }
 
@@ -887,23 +887,27 @@ static std::pair<int, std::vector<unsigned char>> load_sound_resource(glui32 snd
         const auto &resource_map = gli_get_resource_map(giblorb_ID_Snd);
         if (!resource_map.empty()) {
             try {
-                data = resource_map.at(snd);
+                const auto &resource = resource_map.at(snd);
+                data = garglk::ByteSpan(resource.data(), resource.size());
             } catch (const std::out_of_range &) {
                 throw SoundError("invalid resource");
             }
         } else {
             auto filename = Format("{}/SND{}", gli_workdir, snd);
+            std::vector<unsigned char> buf;
 
-            if (!garglk::read_file(filename, data)) {
+            if (!garglk::read_file(filename, buf)) {
                 throw SoundError("can't open SND file");
             }
+
+            data = garglk::ByteSpan(std::move(buf));
         }
 
         return {detect_format(data), data};
     }
 }
 
-static glui32 gli_schannel_play_ext(schanid_t chan, glui32 snd, glui32 repeats, glui32 notify, const std::function<std::pair<int, std::vector<unsigned char>>(glui32)> &load_resource)
+static glui32 gli_schannel_play_ext(schanid_t chan, glui32 snd, glui32 repeats, glui32 notify, const std::function<std::pair<int, garglk::ByteSpan>(glui32)> &load_resource)
 {
     if (chan == nullptr) {
         gli_strict_warning("schannel_play_ext: invalid id.");
@@ -919,7 +923,7 @@ static glui32 gli_schannel_play_ext(schanid_t chan, glui32 snd, glui32 repeats,
     std::shared_ptr<SoundSource> source;
     try {
         int type;
-        std::vector<unsigned char> data;
+        garglk::ByteSpan data;
 
         std::tie(type, data) = load_resource(snd);
 
@@ -70,7 +70,7 @@ struct glk_schannel_struct {
     Mix_Music *music;
 
     SDL_RWops *sdl_rwops;
-    std::vector<unsigned char> sdl_memory;
+    garglk::ByteSpan sdl_memory;
     int sdl_channel;
 
     int resid; // for notifies
@@ -200,7 +200,7 @@ static void cleanup_channel(schanid_t chan)
         chan->sdl_rwops = nullptr;
     }
 
-    chan->sdl_memory.clear();
+    chan->sdl_memory = garglk::ByteSpan();
 
     switch (chan->status) {
     case CHANNEL_SOUND:
@@ -468,7 +468,7 @@ static void sound_completion_callback(int chan)
     return;
 }
 
-static int detect_format(const std::vector<unsigned char> &buf)
+static int detect_format(const garglk::ByteSpan &buf)
 {
     const std::vector<std::pair<std::pair<long, std::vector<std::string>>, unsigned long>> formats = {
         // AIFF
@@ -525,24 +525,23 @@ static int detect_format(const std::vector<unsigned char> &buf)
     return 0;
 }
 
-static int load_bleep_resource(glui32 snd, std::vector<unsigned char> &buf)
+static int load_bleep_resource(glui32 snd, garglk::ByteSpan &buf)
 {
     if (snd != 1 && snd != 2) {
         return 0;
     }
 
-    const auto &bleep = gli_bleeps.at(snd);
-    buf.assign(bleep.begin(), bleep.end());
+    buf = garglk::ByteSpan(gli_bleeps.at(snd));
 
     return detect_format(buf);
 }
 
-static glui32 load_sound_resource(glui32 snd, std::vector<unsigned char> &buf)
+static glui32 load_sound_resource(glui32 snd, garglk::ByteSpan &buf)
 {
     if (giblorb_get_resource_map() != nullptr) {
         glui32 type;
 
-        if (!giblorb_copy_resource(giblorb_ID_Snd, snd, type, buf)) {
+        if (!giblorb_get_resource_span(giblorb_ID_Snd, snd, type, buf)) {
             return 0;
         }
 
@@ -551,16 +550,20 @@ static glui32 load_sound_resource(glui32 snd, std::vector<unsigned char> &buf)
         const auto &resource_map = gli_get_resource_map(giblorb_ID_Snd);
         if (!resource_map.empty()) {
             try {
-                buf = resource_map.at(snd);
+                const auto &resource = resource_map.at(snd);
+                buf = garglk::ByteSpan(resource.data(), resource.size());
             } catch (const std::out_of_range &) {
                 return 0;
             }
         } else {
             auto filename = Format("{}/SND{}", gli_workdir, snd);
+            std::vector<unsigned char> data;
 
-            if (!garglk::read_file(filename, buf)) {
+            if (!garglk::read_file(filename, data)) {
                 return 0;
             }
+
+            buf = garglk::ByteSpan(std::move(data));
         }
 
         return detect_format(buf);
@@ -647,7 +650,7 @@ static glui32 play_mod(schanid_t chan)
     return 0;
 }
 
-static glui32 gli_schannel_play_ext(schanid_t chan, glui32 snd, glui32 repeats, glui32 notify, std::function<glui32(glui32, std::vector<unsigned char> &)> load_resource)
+static glui32 gli_schannel_play_ext(schanid_t chan, glui32 snd, glui32 repeats, glui32 notify, std::function<glui32(glui32, garglk::ByteSpan &)> load_resource)
 {
     glui32 type;
     glui32 result = 0;
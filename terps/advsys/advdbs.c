@@ -47,6 +47,34 @@ static long saveoff;	/* save data file offset */
 static char *save;	/* save area base address */
 static glui32 slen;	/* save area length */
 
+/* lookup indices, built once by db_index since the structure of the
+   tables never changes during play, only property values do */
+struct pair {
+    long key;		/* what to look up */
+    int val;		/* what it maps to */
+    int seq;		/* order added, to keep the first of duplicates */
+};
+struct lookup {
+    struct pair *pairs;	/* pairs sorted by key */
+    int npairs;
+    int *hash;		/* index of the first pair for each key, or -1 */
+    int mask;		/* hash table size - 1 */
+};
+static int *whash;		/* word table index (1..wcount), 0 if empty */
+static int wmask;		/* word hash table size - 1 */
+static struct lookup verbidx;	/* (verb, preposition) to actions */
+static struct lookup propidx;	/* (object, property) to value location */
+static struct lookup nounidx;	/* (object, noun) */
+static struct lookup adjidx;	/* (object, adjective) */
+
+/* the preposition part of a verbidx key when there isn't one */
+#define NOPREP	0
+#define okey(o,w)	((long)(o) * 0x10000L + (w))
+
+static void db_index(void);
+static unsigned int strhash(char *str);
+static int lookup(struct lookup *l,long key);
+
 /* db_init - read and decode the data file header */
 void db_init(strid_t realfd)
 {
@@ -128,6 +156,9 @@ void db_init(strid_t realfd)
     /* set the object count */
     setvalue(V_OCOUNT,ocount);
 
+    /* build the lookup indices */
+    db_index();
+
 	/* CHANGED FOR GLK */
 
 #ifdef GARGLK
@@ -191,8 +222,8 @@ int findword(char *word)
     strncpy(sword,word,WRDSIZE); sword[WRDSIZE] = 0;
 
     /* look up the word */
-    for (i = 1; i <= wcount; i++) {
-	wrd = getwloc(i);
+    for (i = strhash(sword) & wmask; whash[i]; i = (i + 1) & wmask) {
+	wrd = getwloc(whash[i]);
 	if (strcmp(base+wrd+2,sword) == 0)
 	    return (getword(wrd));
     }
@@ -221,11 +252,13 @@ int match(int obj,int noun,int *adjs)
 /* checkverb - check to see if this is a valid verb */
 int checkverb(int *verbs)
 {
-    int act;
+    int i,act;
 
-    /* look up the action */
-    for (act = 1; act <= acount; act++)
-	if (hasverb(act,verbs))
+    /* look up the action among those using this verb */
+    if ((i = lookup(&verbidx,okey(verbs[0],NOPREP))) < 0)
+	return (NIL);
+    for (; i < verbidx.npairs && verbidx.pairs[i].key == okey(verbs[0],NOPREP); i++)
+	if (hasverb(act = verbidx.pairs[i].val,verbs))
 	    return (act);
     return (NIL);
 }
@@ -233,12 +266,15 @@ int checkverb(int *verbs)
 /* findaction - find an action matching a description */
 int findaction(int *verbs,int preposition,int flag)
 {
-    int act,mask;
+    int i,act,mask;
+    long key;
 
-    /* look up the action */
-    for (act = 1; act <= acount; act++) {
-	if (preposition && !haspreposition(act,preposition))
-	    continue;
+    /* look up the action among those using this verb and preposition */
+    key = okey(verbs[0],preposition ? preposition : NOPREP);
+    if ((i = lookup(&verbidx,key)) < 0)
+	return (NIL);
+    for (; i < verbidx.npairs && verbidx.pairs[i].key == key; i++) {
+	act = verbidx.pairs[i].val;
 	if (!hasverb(act,verbs))
 	    continue;
 	mask = ~getabyte(act,A_MASK);
@@ -251,23 +287,27 @@ int findaction(int *verbs,int preposition,int flag)
 /* getp - get the value of an object property */
 int getp(int obj,int prop)
 {
-    int p;
+    int i;
 
-    for (; obj; obj = getofield(obj,O_CLASS))
-	if (p = findprop(obj,prop))
-	    return (getofield(obj,p));
-    return (NIL);
+    if (obj == NIL)
+	return (NIL);
+    getoloc(obj);	/* check the object number */
+    if (prop < 0 || prop > 0xFFFF || (i = lookup(&propidx,okey(obj,prop))) < 0)
+	return (NIL);
+    return (getword(propidx.pairs[i].val));
 }
 
 /* setp - set the value of an object property */
 int setp(int obj,int prop,int val)
 {
-    int p;
+    int i;
 
-    for (; obj; obj = getofield(obj,O_CLASS))
-	if (p = findprop(obj,prop))
-	    return (putofield(obj,p,val));
-    return (NIL);
+    if (obj == NIL)
+	return (NIL);
+    getoloc(obj);	/* check the object number */
+    if (prop < 0 || prop > 0xFFFF || (i = lookup(&propidx,okey(obj,prop))) < 0)
+	return (NIL);
+    return (putword(propidx.pairs[i].val,val));
 }
 
 /* findprop - find a property */
@@ -285,23 +325,20 @@ int findprop(int obj,int prop)
 /* hasnoun - check to see if an object has a specified noun */
 int hasnoun(int obj,int noun)
 {
-    while (obj) {
-	if (inlist(getofield(obj,O_NOUNS),noun))
-	    return (TRUE);
-	obj = getofield(obj,O_CLASS);
-    }
-    return (FALSE);
+    if (obj == NIL)
+	return (FALSE);
+    getoloc(obj);	/* check the object number */
+    return (noun >= 0 && noun <= 0xFFFF && lookup(&nounidx,okey(obj,noun)) >= 0);
 }
 
 /* hasadjective - check to see if an object has a specified adjective */
 int hasadjective(int obj,int adjective)
 {
-    while (obj) {
-	if (inlist(getofield(obj,O_ADJECTIVES),adjective))
-	    return (TRUE);
-	obj = getofield(obj,O_CLASS);
-    }
-    return (FALSE);
+    if (obj == NIL)
+	return (FALSE);
+    getoloc(obj);	/* check the object number */
+    return (adjective >= 0 && adjective <= 0xFFFF
+	 && lookup(&adjidx,okey(obj,adjective)) >= 0);
 }
 
 /* hasverb - check to see if this action has this verb */
@@ -453,6 +490,161 @@ int putdword(char *p,int w)
     return (w);
 }
 
+/* strhash - hash a (shortened) word */
+static unsigned int strhash(char *str)
+{
+    unsigned int h;
+
+    for (h = 0; *str; str++)
+	h = h * 31 + (*str & 0xFF);
+    return (h);
+}
+
+/* keyhash - hash a lookup key */
+static unsigned int keyhash(long key)
+{
+    return ((unsigned int)key * 2654435761U) >> 8;
+}
+
+/* tablesize - return a power of two hash table size for n entries */
+static int tablesize(int n)
+{
+    int size;
+
+    for (size = 16; size < n * 2; size <<= 1)
+	;
+    return (size);
+}
+
+/* paircmp - order pairs by key, then by the order they were added */
+static int paircmp(const void *a,const void *b)
+{
+    const struct pair *pa = a, *pb = b;
+
+    if (pa->key != pb->key)
+	return (pa->key < pb->key ? -1 : 1);
+    return (pa->seq - pb->seq);
+}
+
+/* addpair - add a pair to a lookup that's being built */
+static void addpair(struct lookup *l,int *size,long key,int val)
+{
+    if (l->npairs == *size) {
+	*size = (*size ? *size * 2 : 64);
+	if ((l->pairs = realloc(l->pairs,*size * sizeof(struct pair))) == NULL)
+	    error("insufficient memory");
+    }
+    l->pairs[l->npairs].key = key;
+    l->pairs[l->npairs].val = val;
+    l->pairs[l->npairs].seq = l->npairs;
+    l->npairs++;
+}
+
+/* addlist - add pairs for each word of a list that isn't already there */
+static void addlist(struct lookup *l,int *size,int first,int obj,int link)
+{
+    int word,i;
+
+    for (; link != NIL; link = getword(link+L_NEXT)) {
+	word = getword(link+L_DATA);
+	for (i = first; i < l->npairs; i++)
+	    if (l->pairs[i].key == okey(obj,word))
+		break;
+	if (i == l->npairs)
+	    addpair(l,size,okey(obj,word),0);
+    }
+}
+
+/* finish - sort a lookup and hash the first pair of each key */
+static void finish(struct lookup *l)
+{
+    int i,h;
+
+    qsort(l->pairs,l->npairs,sizeof(struct pair),paircmp);
+    l->mask = tablesize(l->npairs) - 1;
+    if ((l->hash = malloc((l->mask + 1) * sizeof(int))) == NULL)
+	error("insufficient memory");
+    for (i = 0; i <= l->mask; i++)
+	l->hash[i] = -1;
+    for (i = 0; i < l->npairs; i++) {
+	if (i > 0 && l->pairs[i].key == l->pairs[i-1].key)
+	    continue;
+	for (h = keyhash(l->pairs[i].key) & l->mask; l->hash[h] >= 0; h = (h + 1) & l->mask)
+	    ;
+	l->hash[h] = i;
+    }
+}
+
+/* lookup - find the first pair with a key, or -1 if there isn't one */
+static int lookup(struct lookup *l,long key)
+{
+    int h;
+
+    for (h = keyhash(key) & l->mask; l->hash[h] >= 0; h = (h + 1) & l->mask)
+	if (l->pairs[l->hash[h]].key == key)
+	    return (l->hash[h]);
+    return (-1);
+}
+
+/* db_index - build the word, action, property and noun lookups */
+static void db_index(void)
+{
+    int vsize = 0, psize = 0, nsize = 0, asize = 0;
+    int i,h,wrd,act,link,word,prep,obj,cls,depth,first,n,p,prop;
+
+    /* hash the dictionary, keeping the first of any duplicate words */
+    wmask = tablesize(wcount) - 1;
+    if ((whash = calloc(wmask + 1,sizeof(int))) == NULL)
+	error("insufficient memory");
+    for (i = 1; i <= wcount; i++) {
+	wrd = getwloc(i);
+	for (h = strhash(base+wrd+2) & wmask; whash[h]; h = (h + 1) & wmask)
+	    if (strcmp(base+getwloc(whash[h])+2,base+wrd+2) == 0)
+		break;
+	if (whash[h] == 0)
+	    whash[h] = i;
+    }
+
+    /* file each action under the first word of each of its verbs, both
+       on its own and with each of the action's prepositions */
+    for (act = 1; act <= acount; act++)
+	for (link = getafield(act,A_VERBS); link != NIL; link = getword(link+L_NEXT)) {
+	    if ((word = getword(link+L_DATA)) == NIL)
+		continue;
+	    word = getword(word+L_DATA);
+	    addpair(&verbidx,&vsize,okey(word,NOPREP),act);
+	    for (prep = getafield(act,A_PREPOSITIONS); prep != NIL; prep = getword(prep+L_NEXT))
+		addpair(&verbidx,&vsize,okey(word,getword(prep+L_DATA)),act);
+	}
+    finish(&verbidx);
+
+    /* resolve the properties, nouns and adjectives of each object,
+       including those inherited from its classes */
+    for (obj = 1; obj <= ocount; obj++) {
+	first = propidx.npairs;
+	for (cls = obj, depth = 0; cls && depth <= ocount; cls = getofield(cls,O_CLASS), depth++) {
+	    n = getofield(cls,O_NPROPERTIES);
+	    for (i = p = 0; i < n; i++, p += 4) {
+		prop = getofield(cls,O_PROPERTIES+p) & ~P_CLASS;
+		for (h = first; h < propidx.npairs; h++)
+		    if (propidx.pairs[h].key == okey(obj,prop))
+			break;
+		if (h == propidx.npairs)
+		    addpair(&propidx,&psize,okey(obj,prop),getoloc(cls)+O_PROPERTIES+p+2);
+	    }
+	}
+	first = nounidx.npairs;
+	for (cls = obj, depth = 0; cls && depth <= ocount; cls = getofield(cls,O_CLASS), depth++)
+	    addlist(&nounidx,&nsize,first,obj,getofield(cls,O_NOUNS));
+	first = adjidx.npairs;
+	for (cls = obj, depth = 0; cls && depth <= ocount; cls = getofield(cls,O_CLASS), depth++)
+	    addlist(&adjidx,&asize,first,obj,getofield(cls,O_ADJECTIVES));
+    }
+    finish(&propidx);
+    finish(&nounidx);
+    finish(&adjidx);
+}
+
 /* nerror - handle errors with numeric arguments */
 void nerror(char *fmt,int n)
 {
@@ -278,6 +278,8 @@ void agil_option(int optnum,char *optstr[], rbool setflag, rbool lastpass)
   else if (opt("input_bold")) PURE_INPUT=setflag;
   else if (opt("force_load")) FORCE_VERSION=setflag;
   else if (opt("stable_random")) stable_random=setflag;
+  else if (opt("undo_levels") && optnum>=2)
+    undo_levels=strtol(optstr[1],NULL,10);
   else if (!agt_option(optnum,optstr,setflag)) /* Platform specific options */
     rprintf("Invalid option %s\n",optstr[0]);
 }
@@ -471,7 +473,7 @@ static void game_end(void)
       else writeln("(RESTORE failed)");
     else if (strncasecmp(s,"UNDO",4)==0)
       if (can_undo && undo_state!=NULL)
-	{putstate(undo_state);done_flag=1;}
+	{restore_undo_state();done_flag=1;}
       else writeln("Insufficiant memory to support UNDO");
     else if (toupper(s[0])=='Q')
       {quitflag=1;done_flag=1;}
@@ -798,6 +800,7 @@ static fc_type setup_game(fc_type fc)
   verboseflag=1;notify_flag=0;logflag=0;menu_mode=0;
   fast_replay=0;
   stable_random=BATCH_MODE || make_test;
+  undo_levels=20;
   if (make_test) BATCH_MODE=0;
   hold_fc=fc;
   set_default_filenames(fc);
@@ -901,7 +904,7 @@ void close_game(void)
  /* Now free everything in sight; this _shouldn't_ be necessary,
     but why take chances? */
   free_all_agtread();
-  rfree(restart_state);rfree(undo_state);
+  rfree(restart_state);rfree(undo_state);free_undo_log();
   rfree(pictable);rfree(save_lnoun);
   rfree(verbptr);rfree(verbend);
   rfree(agt_counter);rfree(agt_var);
@@ -1094,6 +1094,8 @@ uchar *buffread(long index);
     /* seek to index*recsize, read buff_rsize bytes, return pointer to a 
        buffer with them. */
 void buffclose(void); /* Close the current file */
+char *buffmap(long offset, long size);
+    /* Map part of the current file into memory; NULL on failure */
 
 void bw_open(fc_type fc,filetype ext); /* Open buffered file for writing */
 void bw_close(void); /* Close buffered file */
@@ -1170,6 +1172,9 @@ rbool binread(genfile f, void *buff, long recsize, long recnum, char **errstr);
 long varread(genfile f, void *buff, long recsize, long recnum, char **errstr);
 rbool binwrite(genfile f, void *buff, long recsize, long recnum, rbool ferr);
 long binsize(genfile f); /* Size of an open binary file */
+void *binmap(genfile f, long offset, long size);
+     /* Map part of a file into memory; NULL if this isn't possible */
+void binunmap(void *p, long offset, long size);
 
 rbool textrewind(genfile f);
 
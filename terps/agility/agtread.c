@@ -27,6 +27,12 @@ int topcmd;    /* The highest legal opcode in the current AGT version. */
 
 static genfile fd_desc;  /* File pointer for description file. */
 static long desc_size;  /* Size of description file. */
+static uchar *descr_done; /* If the description file is mapped into
+			     memory, a bitmap of the lines decoded so far */
+static long descr_lines;  /* Number of lines in the mapped file, counting
+			     an unterminated last line */
+static tline descr_tail;  /* Decoded copy of that unterminated line, which
+			     doesn't fit in the mapping */
 
 static int top_quest; /* Highest question actually referenced */
      /* This is computed by fixcmd */
@@ -188,8 +194,23 @@ void open_descr(fc_type fc)
     if (encrypt_desc) rprintf(" [encrypted]\n"); 
     else rprintf("  [plaintext: %d/%d]\n",alpha,cnt);}
 
-  mem_descr=NULL;
-  if (desc_size<=descr_maxmem) {
+  /* If we can map the file, leave the lines encoded until they are
+     first read, so opening a large game costs nothing up front */
+  mem_descr=binmap(fd_desc,0,desc_size);
+  if (mem_descr!=NULL) {
+    i=desc_size/sizeof(tline)/8+1;
+    descr_done=rmalloc(i);
+    memset(descr_done,0,i);
+    descr_lines=(desc_size+sizeof(tline)-1)/sizeof(tline);
+    if (desc_size%sizeof(tline)!=0) {
+      memset(descr_tail,0,sizeof(tline));
+      memcpy(descr_tail,mem_descr+(descr_lines-1)*sizeof(tline),
+	     desc_size%sizeof(tline));
+      convert_agt_descr((uchar*)descr_tail);
+    }
+    readclose(fd_desc);
+    fd_desc=NULL;
+  } else if (desc_size<=descr_maxmem) {
     /* This is where we need to read the data in and convert it:
        encrypted Pascal strings --> plaintext C strings */   
     binseek(fd_desc,0);
@@ -206,7 +227,11 @@ void open_descr(fc_type fc)
 
 void close_descr(void)
 {
-  if (mem_descr!=NULL) 
+  if (descr_done!=NULL) {
+    binunmap(mem_descr,0,desc_size);
+    mem_descr=NULL;
+    rfree(descr_done);
+  } else if (mem_descr!=NULL)
     rfree(mem_descr);
   else {
     readclose(fd_desc);
@@ -219,13 +244,30 @@ descr_line *agt_read_descr(long start,long len)
 {
   tline *d;
   descr_line *lines;
-  long i;
+  long i, n;
   char *errstr;
 
   if (len==-1 || start==-1) return NULL;
   lines=rmalloc(sizeof(descr_line)*(len+1));
 
-  if (mem_descr!=NULL) {
+  if (descr_done!=NULL) {
+    /* Reading past the end of the file fails just as binread() would */
+    if (start<0 || start+len>descr_lines)
+      fatal("Unexpected end of file.");
+    d=((tline*)mem_descr)+start;
+    for(i=0;i<len;i++) {
+      n=start+i;
+      if ((n+1)*(long)sizeof(tline)>desc_size) {
+	lines[i]=(char*)descr_tail;
+	continue;
+      }
+      lines[i]=(char*)(d+i);
+      if (!(descr_done[n>>3] & (1<<(n&7)))) {
+	convert_agt_descr((uchar*)(d+i));
+	descr_done[n>>3]|=1<<(n&7);
+      }
+    }
+  } else if (mem_descr!=NULL) {
     d=((tline*)mem_descr)+start;
     for(i=0;i<len;i++)
       lines[i]=(char*)(d+i);
@@ -598,9 +598,34 @@ static void fix_objflag_str(rbool to_intern)
 
 static long descr_ofs;
 
+/* If the description block is mapped into memory, it is decoded
+   DESCR_CHUNK bytes at a time as it is read; descr_done records which
+   chunks have been decoded so far. */
+#define DESCR_CHUNK 256
+static uchar *descr_done;
+static long descr_map_ofs, descr_map_size;
+
+static void decode_descr(long start, long size)
+{
+  long c, i, end;
+
+  for(c=start/DESCR_CHUNK;c*DESCR_CHUNK<start+size;c++) {
+    if (descr_done[c>>3] & (1<<(c&7))) continue;
+    end=(c+1)*DESCR_CHUNK;
+    if (end>descr_map_size) end=descr_map_size;
+    for(i=c*DESCR_CHUNK;i<end;i++)
+      mem_descr[i]=trans_ascii[ ((uchar*)mem_descr)[i]^'r' ];
+    descr_done[c>>3]|=1<<(c&7);
+  }
+}
+
 void agx_close_descr(void)
 {
-  if (mem_descr!=NULL)
+  if (descr_done!=NULL) {
+    binunmap(mem_descr,descr_map_ofs,descr_map_size);
+    mem_descr=NULL;
+    rfree(descr_done);
+  } else if (mem_descr!=NULL)
     rfree(mem_descr);
   else if (descr_ofs!=-1)
     buffclose(); /* This closes the whole AGX file */  
@@ -617,8 +642,15 @@ descr_line *agx_read_descr(long start,long size)
   if (mem_descr==NULL && descr_ofs!=-1)
     buff=read_recblock(NULL,FT_CHAR,size,
 		       descr_ofs+start, size*ft_leng[FT_CHAR]);
-  else 
+  else {
+    if (descr_done!=NULL) {
+      /* Reading past the end of the block fails as buff_blockread() would */
+      if (start<0 || start+size>descr_map_size)
+	fatal("Unexpected end of file.");
+      decode_descr(start,size);
+    }
     buff=mem_descr+start;
+  }
 
   len=0;
   for(i=0;i<size;i++)   /* Count the number of lines */
@@ -1136,7 +1168,17 @@ int read_agx(fc_type fc, rbool diag)
 
   /* Block 11 is description block; it doesn't get read in by
      agxread() but during play */
-  if (index[11].blocksize<=descr_maxmem) {
+  descr_done=NULL;
+  mem_descr=buffmap(index[11].file_offset,index[11].numrec);
+  if (mem_descr!=NULL) {
+    /* ... if we could map them, in which case they get decoded lazily */
+    descr_map_ofs=index[11].file_offset;
+    descr_map_size=index[11].numrec;
+    descr_done=rmalloc(descr_map_size/DESCR_CHUNK/8+1);
+    memset(descr_done,0,descr_map_size/DESCR_CHUNK/8+1);
+    buffclose();
+    descr_ofs=-1;
+  } else if (index[11].blocksize<=descr_maxmem) {
     /* ... if we decided to load descriptions into memory */
     mem_descr=read_recblock(NULL,FT_CHAR,index[11].numrec,
 			    index[11].file_offset, 
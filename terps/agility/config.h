@@ -91,6 +91,9 @@
        be defined. (Giving the flags needed for opening a file for
        reading or writing, and the file permissions to be given to newly
        created files. */  
+/*   HAVE_MMAP  if you have mmap(). Description text is then mapped
+       into memory and decoded as it is needed, regardless of 
+       DESCR_BUFFSIZE. */
 /*   OPEN_AS_TEXT  Define to cause text files to be opened as text files. */
 /*   PREFIX_EXT  Add filename extensions at the beginning of the name, 
        rather than at the end. */
@@ -311,6 +314,9 @@
 #define REPLACE_GETFILE			/* Override get_user_file. */
 #define REPLACE_MAIN			/* Override main. */
 #define fnamecmp	strcasecmp	/* Case insensitive filename compare. */
+#ifndef _WIN32
+#define HAVE_MMAP			/* Map description text. */
+#endif
 #undef PLAIN
 
 #if 0
@@ -353,6 +359,7 @@
 #ifdef UNIX
 #define HAVE_SLEEP
 #define UNIX_IO
+#define HAVE_MMAP
 #define READFLAG O_RDONLY
 #define WRITEFLAG (O_WRONLY|O_CREAT|O_TRUNC)
 #define FILE_PERM (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
@@ -38,6 +38,12 @@ int pclose(FILE *p);
 #endif
 #endif /* UNIX_IO */
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef force16
 #define int short
 #endif
@@ -727,6 +733,46 @@ long binsize(genfile f)
   return leng;
 }
 
+/* Maps size bytes of f, starting at offset, into memory. The mapping
+   is private, so the caller may decode it in place without touching
+   the file; it stays valid after f is closed, until binunmap().
+   Returns NULL if the platform or the file (e.g. a pipe) doesn't
+   support mapping, in which case the caller should read it instead. */
+void *binmap(genfile f, long offset, long size)
+{
+#ifdef HAVE_MMAP
+  long pageofs;
+  char *p;
+  struct stat st;
+
+  assert(f!=NULL);
+  if (size<=0) return NULL;
+  /* Touching a mapped page past the end of the file raises SIGBUS, so
+     leave truncated files to the ordinary read path, which reports the
+     error properly. */
+  if (fstat(fileno(f),&st)!=0 || offset<0 || offset+size>st.st_size)
+    return NULL;
+  pageofs=offset % sysconf(_SC_PAGESIZE);
+  p=mmap(NULL,size+pageofs,PROT_READ|PROT_WRITE,MAP_PRIVATE,
+	 fileno(f),offset-pageofs);
+  if (p==MAP_FAILED) return NULL;
+  return p+pageofs;
+#else
+  return NULL;
+#endif
+}
+
+void binunmap(void *p, long offset, long size)
+{
+#ifdef HAVE_MMAP
+  long pageofs;
+
+  if (p==NULL) return;
+  pageofs=offset % sysconf(_SC_PAGESIZE);
+  munmap((char*)p-pageofs,size+pageofs);
+#endif
+}
+
 rbool textrewind(genfile f)
 {
   assert(f!=NULL);
@@ -100,6 +100,7 @@ global rbool notify_flag, listexit_flag, menu_mode;
 global rbool cmd_saveable; /* set indicates that this command can be repeated
 		     with AGAIN. */
 global rbool can_undo;  /* Can we UNDO the last turn? */
+global int undo_levels; /* How many turns can be undone */
 
 global uchar *restart_state, *undo_state; /* Store old game states for 
 				     RESTART and UNDO */
@@ -420,6 +421,9 @@ void init_state_sys(void);  /* Must be called before either of the following */
 uchar *getstate(uchar *gs); 
     /* Returns malloc'd block containing game state. */
 void putstate(uchar *gs); /* Restores games state. */
+void save_undo_state(void); /* Called before each line of commands */
+void restore_undo_state(void); /* UNDO the last line of commands */
+void free_undo_log(void);
 void init_vals(void);  /* Compute dependent variables
 			  such as totwt, totsize, etc. */
 void restart_game(void);
@@ -1317,14 +1317,13 @@ static void v_undo(void)
   if (can_undo==0) {
     if (newlife_flag)
       writeln("You can't UNDO on the first turn.");
-    else writeln("You can only UNDO one turn.");
+    else writeln("You can't UNDO any further.");
     ip=-1;
     return;
   }
   writeln("");
   writeln("UNDOing a turn...");
-  can_undo=0;
-  putstate(undo_state);
+  restore_undo_state();
   ip=1;
   set_statline();
   return;
@@ -1428,10 +1427,8 @@ rbool parse(void)
    we save the undo state before executing if this is the first command
    in a sequence. (That is, UNDO undoes whole lines of commands,
    not just individual commands) */
-  if (start_ip==0 && undo_state!=NULL) {
-	undo_state=getstate(undo_state);
-	can_undo=1;
-      }
+  if (start_ip==0)
+    save_undo_state();
 
 /* Now to actually execute the command that has been parsed. */
 /* Remember: disambiguation has been done by this time. */
@@ -1555,10 +1552,7 @@ void menu_cmd(void)
     return;
   }
   
-  if (undo_state!=NULL) {
-    undo_state=getstate(undo_state);
-    can_undo=1;
-  }
+  save_undo_state();
 
   /* Now to actually execute the command that has been selected. */
   tmpobj(&actrec);
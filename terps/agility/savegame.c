@@ -10,6 +10,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "agility.h"
 #include "interp.h"
@@ -304,6 +305,155 @@ void putstate(uchar *gs) /* Restores games state. */
   }
 }
 
+/*-------------------------------------------------------------------*/
+/*  UNDO LOG   */
+/* undo_state holds the game state from before the last line of commands.
+   The states before that are kept in a log of differences: each entry
+   holds the bytes of one state that differ from the state following it,
+   so only what a turn changed is stored. The log is a ring of
+   undo_levels-1 entries; when it is full, the oldest entry is dropped. */
+
+/* A difference is a sequence of runs, each with a two byte count of
+   unchanged bytes to skip, a two byte count of changed bytes, and then
+   the changed bytes themselves (from the older state). */
+
+typedef struct {
+  uchar *diff;
+  long size;
+} undo_rec;
+
+static undo_rec *undo_log=NULL;
+static int undo_first, undo_cnt, undo_max;
+static uchar *undo_scratch=NULL; /* Buffer for the newest state */
+
+static long diff_runs(uchar *old_gs, uchar *new_gs, uchar *diff)
+/* Encodes the bytes of old_gs that differ from new_gs into diff,
+   returning the size of the encoding. If diff is NULL, just
+   computes the size. */
+{
+  long i, size, skip, len;
+
+  size=0;
+  for(i=0;i<state_size;) {
+    for(skip=0;i<state_size && skip<0xFFFF && old_gs[i]==new_gs[i];skip++) i++;
+    if (i==state_size) break;
+    for(len=0;i+len<state_size && len<0xFFFF && old_gs[i+len]!=new_gs[i+len];
+	len++);
+    if (diff!=NULL) {
+      diff[size]=skip&0xFF; diff[size+1]=(skip>>8)&0xFF;
+      diff[size+2]=len&0xFF; diff[size+3]=(len>>8)&0xFF;
+      memcpy(diff+size+4,old_gs+i,len);
+    }
+    size+=4+len;
+    i+=len;
+  }
+  return size;
+}
+
+static void apply_diff(uchar *gs, uchar *diff, long size)
+{
+  long i, pos, len;
+
+  for(i=pos=0;pos<size;) {
+    i+=diff[pos]+(((long)diff[pos+1])<<8);
+    len=diff[pos+2]+(((long)diff[pos+3])<<8);
+    memcpy(gs+i,diff+pos+4,len);
+    i+=len;
+    pos+=4+len;
+  }
+}
+
+static void drop_oldest_undo(void)
+{
+  rfree(undo_log[undo_first].diff);
+  undo_first=(undo_first+1)%undo_max;
+  undo_cnt--;
+}
+
+static void log_undo(uchar *old_gs, uchar *new_gs)
+/* Adds the difference leading back from new_gs to old_gs to the log */
+{
+  undo_rec *rec;
+  long size;
+  uchar *diff;
+
+  if (undo_levels<=1) return;
+  if (undo_log==NULL) {
+    undo_max=undo_levels-1;
+    undo_first=undo_cnt=0;
+    rm_trap=0;
+    undo_log=rmalloc(undo_max*sizeof(undo_rec));
+    rm_trap=1;
+    if (undo_log==NULL) return;
+  }
+  size=diff_runs(old_gs,new_gs,NULL);
+  rm_trap=0;
+  diff=(size>0) ? rmalloc(size) : NULL;
+  rm_trap=1;
+  if (size>0 && diff==NULL) {  /* Out of memory: give up on older turns */
+    while(undo_cnt>0) drop_oldest_undo();
+    return;
+  }
+  diff_runs(old_gs,new_gs,diff);
+  if (undo_cnt==undo_max) drop_oldest_undo();
+  rec=&undo_log[(undo_first+undo_cnt)%undo_max];
+  rec->diff=diff;
+  rec->size=size;
+  undo_cnt++;
+}
+
+void save_undo_state(void)
+/* Record the game state before a new line of commands is executed */
+{
+  uchar *tmp;
+
+  if (undo_state==NULL) return;
+  if (can_undo && undo_scratch==NULL)
+    undo_scratch=getstate(NULL);
+  if (!can_undo || undo_scratch==NULL) {
+    /* Nothing worth keeping in undo_state, or no room to keep it.
+       Either way the logged differences lead back from the old
+       undo_state, so they go too. */
+    while(undo_cnt>0) drop_oldest_undo();
+    undo_state=getstate(undo_state);
+    can_undo=1;
+    return;
+  }
+  undo_scratch=getstate(undo_scratch);
+  log_undo(undo_state,undo_scratch);
+  tmp=undo_state;
+  undo_state=undo_scratch;
+  undo_scratch=tmp;
+}
+
+void restore_undo_state(void)
+/* Return to the state before the last line of commands, and step
+   undo_state back to the state before the one restored */
+{
+  undo_rec *rec;
+
+  putstate(undo_state);
+  if (undo_cnt==0) {
+    can_undo=0;
+    return;
+  }
+  undo_cnt--;
+  rec=&undo_log[(undo_first+undo_cnt)%undo_max];
+  apply_diff(undo_state,rec->diff,rec->size);
+  rfree(rec->diff);
+  can_undo=1;
+}
+
+void free_undo_log(void)
+{
+  if (undo_log!=NULL) {
+    while(undo_cnt>0) drop_oldest_undo();
+    rfree(undo_log);
+  }
+  rfree(undo_scratch);
+}
+
+
 void init_state_sys(void)
 /* Initializes the state saving mechanisms */
 /* Mainly it just computes the size of a state block */
@@ -615,6 +615,12 @@ void buffclose(void)
 }
 
 
+char *buffmap(long offset, long size)
+{
+  return binmap(bfile,offset,size);
+}
+
+
 /* This changes the record size and offset settings of the buffered
    file so we can read files that consist of multiple sections with
    different structures */
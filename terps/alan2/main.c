@@ -74,6 +74,7 @@ Aword *scores;			/* Score table pointer */
 Aword *freq;			/* Cumulative character frequencies */
 
 int dictsize;
+Aword *dictClass = NULL;	/* Class bits of each dictionary entry */
 
 Boolean verbose = FALSE;
 Boolean errflg = TRUE;
@@ -1611,6 +1612,7 @@ static void initheader()
   dict = (WrdElem *) addrTo(header->dict);
   /* Find out number of entries in dictionary */
   for (dictsize = 0; !endOfTable(&dict[dictsize]); dictsize++);
+  initDictIndex();
   vrbs = (VrbElem *) addrTo(header->vrbs);
   stxs = (StxElem *) addrTo(header->stxs);
   locs = (LocElem *) addrTo(header->locs);
@@ -42,6 +42,7 @@ extern Aword *scores;		/* Score table pointer */
 extern Aword *freq;		/* Cumulated frequencies */
 
 extern int dictsize;		/* Number of entries in dictionary */
+extern Aword *dictClass;	/* Class bits of each dictionary entry */
 
 /* The text and message file */
 extern FILE *txtfil;
@@ -81,6 +81,13 @@ static char isobuf[LISTLEN+1];	/* The input buffer in ISO */
 
 static Boolean eol = TRUE;	/* Looking at End of line? Yes, initially */
 
+/* Open addressed hash index over the dictionary words. Entries are
+   dictionary indices, inserted in dictionary order, so the first match
+   found is the same entry a linear search would find. */
+#define EMPTY_SLOT (-1)
+static int *dictIndex = NULL;
+static int dictIndexMask;
+
 
 
 #ifdef _PROTOTYPES_
@@ -111,6 +118,67 @@ static void unknown(token)
 static char *token;
 
 
+#ifdef _PROTOTYPES_
+static unsigned int hashwrd(
+     char wrd[]
+)
+#else
+static unsigned int hashwrd(wrd)
+     char wrd[];
+#endif
+{
+  unsigned int hash = 5381;
+
+  while (*wrd != '\0')
+    hash = hash*33 ^ (unsigned char)*wrd++;
+  return (hash);
+}
+
+
+/*----------------------------------------------------------------------
+
+  initDictIndex()
+
+  Copy the class bits of the dictionary into dictClass and build the
+  hash index used by lookup().
+
+  */
+#ifdef _PROTOTYPES_
+void initDictIndex(void)
+#else
+void initDictIndex()
+#endif
+{
+  int size;
+  int i;
+  unsigned int slot;
+
+  if (dictClass != NULL)
+    free(dictClass);
+  if (dictIndex != NULL)
+    free(dictIndex);
+
+  dictClass = (Aword *) allocate((dictsize+1)*sizeof(Aword));
+  for (i = 0; i < dictsize; i++)
+    dictClass[i] = dict[i].class;
+
+  /* Keep the table at most half full */
+  for (size = 16; size < 2*dictsize; size *= 2)
+    ;
+  dictIndexMask = size-1;
+  dictIndex = (int *) allocate(size*sizeof(int));
+  for (i = 0; i < size; i++)
+    dictIndex[i] = EMPTY_SLOT;
+
+  for (i = 0; i < dictsize; i++) {
+    slot = hashwrd((char *) addrTo(dict[i].wrd)) & dictIndexMask;
+    while (dictIndex[slot] != EMPTY_SLOT)
+      slot = (slot+1) & dictIndexMask;
+    dictIndex[slot] = i;
+  }
+}
+
+
 #ifdef _PROTOTYPES_
 static int lookup(
      char wrd[]
@@ -120,11 +188,13 @@ static int lookup(wrd)
      char wrd[];
 #endif
 {
-  int i;
+  unsigned int slot;
 
-  for (i = 0; !endOfTable(&dict[i]); i++) {
-    if (strcmp(wrd, (char *) addrTo(dict[i].wrd)) == 0)
-      return (i);
+  slot = hashwrd(wrd) & dictIndexMask;
+  while (dictIndex[slot] != EMPTY_SLOT) {
+    if (strcmp(wrd, (char *) addrTo(dict[dictIndex[slot]].wrd)) == 0)
+      return (dictIndex[slot]);
+    slot = (slot+1) & dictIndexMask;
   }
   unknown(wrd);
   return(EOF);
@@ -19,9 +19,13 @@ extern int vrbwrd;
 
 #ifdef _PROTOTYPES_
 
+/* Build the dictionary index and class table for a newly loaded game */
+extern void initDictIndex(void);
+
 /* Parse a new player command */
 extern void parse(void);
 
 #else
+extern void initDictIndex();
 extern void parse();
 #endif
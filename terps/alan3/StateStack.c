@@ -106,3 +106,24 @@ void popGameState(StateStackP stateStack, void *gameState, char** playerCommand)
         *playerCommand = stateStack->commands[stateStack->stackPointer];
     }
 }
+
+
+/*======================================================================*/
+int stateStackDepth(StateStackP stateStack) {
+    return stateStack->stackPointer;
+}
+
+
+/*======================================================================*/
+void dropOldestGameState(StateStackP stateStack, void *gameState, char **playerCommand) {
+    if (stateStack->stackPointer == 0)
+        syserr("Dropping GameState from empty stack");
+    else {
+        memcpy(gameState, stateStack->states[0], stateStack->elementSize);
+        deallocate(stateStack->states[0]);
+        *playerCommand = stateStack->commands[0];
+        stateStack->stackPointer--;
+        memmove(&stateStack->states[0], &stateStack->states[1], stateStack->stackPointer*sizeof(void*));
+        memmove(&stateStack->commands[0], &stateStack->commands[1], stateStack->stackPointer*sizeof(char*));
+    }
+}
@@ -19,6 +19,8 @@ extern StateStackP createStateStack(int elementSize);
 extern bool stateStackIsEmpty(StateStackP stateStack);
 extern void pushGameState(StateStackP stateStack, void *state);
 extern void popGameState(StateStackP stateStack, void *state, char **playerCommandPointer);
+extern int stateStackDepth(StateStackP stateStack);
+extern void dropOldestGameState(StateStackP stateStack, void *state, char **playerCommandPointer);
 extern void attachPlayerCommandsToLastState(StateStackP stateStack, char *playerCommand);
 extern void deleteStateStack(StateStackP stateStack);
 
@@ -8,6 +8,8 @@
 /* IMPORTS */
 #include "word.h"
 #include "lists.h"
+#include "memory.h"
+#include "sysdep.h"
 
 /* PUBLIC DATA */
 DictionaryEntry *dictionary;    /* Dictionary pointer */
@@ -15,11 +17,81 @@ int dictionarySize;
 int conjWord;           /* First conjunction in dictionary, for ',' */
 
 
+/* CONSTANTS */
+#define EMPTY_SLOT (-1)
+
+
+/* PRIVATE DATA */
+/* Class bits of each dictionary entry, copied into a flat array */
+static Aword *wordClasses = NULL;
+
+/* Open addressed hash index over the dictionary words, case folded
+   like equalStrings(). Entries are dictionary indices, inserted in
+   dictionary order, so the first match found is the same entry a
+   linear search would find. */
+static int *dictionaryIndex = NULL;
+static int dictionaryIndexMask;
+
+
+/*----------------------------------------------------------------------*/
+static unsigned int hashWord(char *word) {
+    unsigned int hash = 5381;
+
+    while (*word != '\0')
+        hash = hash*33 ^ (unsigned int)toLower(*word++);
+    return hash;
+}
+
+
+/*======================================================================*/
+void buildDictionaryIndex(void) {
+    int size;
+    int i;
+
+    if (wordClasses != NULL)
+        deallocate(wordClasses);
+    if (dictionaryIndex != NULL)
+        deallocate(dictionaryIndex);
+
+    wordClasses = allocate((dictionarySize+1)*sizeof(Aword));
+    for (i = 0; i < dictionarySize; i++)
+        wordClasses[i] = dictionary[i].classBits;
+
+    /* Keep the table at most half full */
+    for (size = 16; size < 2*dictionarySize; size *= 2)
+        ;
+    dictionaryIndexMask = size-1;
+    dictionaryIndex = allocate(size*sizeof(int));
+    for (i = 0; i < size; i++)
+        dictionaryIndex[i] = EMPTY_SLOT;
+
+    for (i = 0; i < dictionarySize; i++) {
+        unsigned int slot = hashWord((char *)pointerTo(dictionary[i].string)) & dictionaryIndexMask;
+        while (dictionaryIndex[slot] != EMPTY_SLOT)
+            slot = (slot+1) & dictionaryIndexMask;
+        dictionaryIndex[slot] = i;
+    }
+}
+
+
+/*======================================================================*/
+int lookupDictionary(char *word) {
+    unsigned int slot = hashWord(word) & dictionaryIndexMask;
+
+    while (dictionaryIndex[slot] != EMPTY_SLOT) {
+        if (equalStrings(word, (char *)pointerTo(dictionary[dictionaryIndex[slot]].string)))
+            return dictionaryIndex[slot];
+        slot = (slot+1) & dictionaryIndexMask;
+    }
+    return EOF;
+}
+
+
 
 /* Word class query methods, move to Word.c */
 /* Word classes are numbers but in the dictionary they are generated as bits */
 static bool isVerb(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&VERB_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&VERB_BIT)!=0;
 }
 
 bool isVerbWord(int wordIndex) {
@@ -27,7 +99,7 @@ bool isVerbWord(int wordIndex) {
 }
 
 bool isConjunction(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&CONJUNCTION_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&CONJUNCTION_BIT)!=0;
 }
 
 bool isConjunctionWord(int wordIndex) {
@@ -35,7 +107,7 @@ bool isConjunctionWord(int wordIndex) {
 }
 
 static bool isExcept(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&EXCEPT_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&EXCEPT_BIT)!=0;
 }
 
 bool isExceptWord(int wordIndex) {
@@ -43,7 +115,7 @@ bool isExceptWord(int wordIndex) {
 }
 
 static bool isThem(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&THEM_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&THEM_BIT)!=0;
 }
 
 bool isThemWord(int wordIndex) {
@@ -51,7 +123,7 @@ bool isThemWord(int wordIndex) {
 }
 
 static bool isIt(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&IT_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&IT_BIT)!=0;
 }
 
 bool isItWord(int wordIndex) {
@@ -59,7 +131,7 @@ bool isItWord(int wordIndex) {
 }
 
 static bool isNoun(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&NOUN_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&NOUN_BIT)!=0;
 }
 
 bool isNounWord(int wordIndex) {
@@ -67,7 +139,7 @@ bool isNounWord(int wordIndex) {
 }
 
 static bool isAdjective(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&ADJECTIVE_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&ADJECTIVE_BIT)!=0;
 }
 
 bool isAdjectiveWord(int wordIndex) {
@@ -75,7 +147,7 @@ bool isAdjectiveWord(int wordIndex) {
 }
 
 static bool isPreposition(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&PREPOSITION_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&PREPOSITION_BIT)!=0;
 }
 
 bool isPrepositionWord(int wordIndex) {
@@ -83,7 +155,7 @@ bool isPrepositionWord(int wordIndex) {
 }
 
 bool isAll(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&ALL_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&ALL_BIT)!=0;
 }
 
 bool isAllWord(int wordIndex) {
@@ -91,7 +163,7 @@ bool isAllWord(int wordIndex) {
 }
 
 static bool isDir(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&DIRECTION_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&DIRECTION_BIT)!=0;
 }
 
 bool isDirectionWord(int wordIndex) {
@@ -99,11 +171,11 @@ bool isDirectionWord(int wordIndex) {
 }
 
 bool isNoise(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&NOISE_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&NOISE_BIT)!=0;
 }
 
 bool isPronoun(int wordCode) {
-  return wordCode < dictionarySize && (dictionary[wordCode].classBits&PRONOUN_BIT)!=0;
+  return wordCode < dictionarySize && (wordClasses[wordCode]&PRONOUN_BIT)!=0;
 }
 
 bool isPronounWord(int wordIndex) {
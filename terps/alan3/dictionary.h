@@ -41,6 +41,9 @@ extern bool isAll(int wordCode);
 extern bool isNoise(int wordCode);
 extern bool isPronoun(int wordCode);
 
+extern void buildDictionaryIndex(void);
+extern int lookupDictionary(char *word);
+
 extern void *generatePronounList(void);
 
 #endif /* DICTIONARY_H_ */
@@ -445,6 +445,7 @@ static void initStaticData(void)
     dictionary = (DictionaryEntry *) pointerTo(header->dictionary);
     /* Find out number of entries in dictionary */
     for (dictionarySize = 0; !isEndOfArray(&dictionary[dictionarySize]); dictionarySize++);
+    buildDictionaryIndex();
 
     /* All addresses to tables indexed by ids are converted to
        pointers, then adjusted to point to the (imaginary) element
@@ -73,15 +73,7 @@ static int number(char token[]) {
 
 /*----------------------------------------------------------------------*/
 static int lookup(char wrd[]) {
-    int i;
-
-    // TODO: Why do we start at 0, is there a word code == 0?
-    for (i = 0; !isEndOfArray(&dictionary[i]); i++) {
-        if (equalStrings(wrd, (char *) pointerTo(dictionary[i].string))) {
-            return i;
-        }
-    }
-    return EOF;
+    return lookupDictionary(wrd);
 }
 
 
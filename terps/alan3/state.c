@@ -21,34 +21,84 @@
 #include "set.h"
 
 
+/* CONSTANTS */
+
+/* Memory the undo stack may use before the oldest states are dropped */
+#define UNDO_MEMORY_LIMIT (2*1024*1024)
+
+
 /* PUBLIC DATA */
 
 
 /* PRIVATE TYPES */
 
+/* Game memory areas that are compared word by word */
+typedef enum Area {
+    ADMIN_AREA,
+    ATTRIBUTE_AREA,
+    SCORE_AREA,
+    AREA_COUNT
+} Area;
+
+typedef struct WordChange {
+    int area;
+    int index;
+    Aword value;                /* Value before the change */
+} WordChange;
+
+typedef struct StringChange {
+    int index;                  /* Index in the string init table */
+    char *value;                /* Value before the change */
+} StringChange;
+
+typedef struct SetChange {
+    int index;                  /* Index in the set init table */
+    Set *value;                 /* Value before the change */
+} SetChange;
+
 /* Implementation of the abstract type typedef struct game_state GameState */
+/* A stacked game state only records how it differs from the state
+   below it on the stack: the previous values of every word, string
+   and set that changed, and the previous event queue if that
+   changed. The full state is only kept for the top of the stack (in
+   'remembered' below), so popping a state steps that copy back. */
 struct game_state {
-    /* Event queue */
+    int score;
+
+    bool eventsChanged;
     EventQueueEntry *eventQueue;
-    int eventQueueTop;			/* Event queue top pointer */
+    int eventQueueTop;
 
-    /* Scores */
-    int score;
-    Aword *scores;				/* Score table pointer */
-
-    /* Instance data */
-    AdminEntry *admin;			/* Administrative data about instances */
-    AttributeEntry *attributes;	/* Attributes data area */
-    /* Sets and strings are dynamically allocated areas for which the
-       attribute is just a pointer to. So they are not catched by the
-       saving of attributes, instead they require special storage */
-    Set **sets;					/* Array of set pointers */
-    char **strings;				/* Array of string pointers */
+    int wordChangeCount;
+    WordChange *wordChanges;
+    int stringChangeCount;
+    StringChange *stringChanges;
+    int setChangeCount;
+    SetChange *setChanges;
+
+    unsigned long size;         /* Memory used by this state */
 };
 
+/* The complete game state on top of the stack */
+typedef struct RememberedState {
+    bool valid;
+    Aword *area[AREA_COUNT];
+    int areaSize[AREA_COUNT];   /* In words */
+    int score;
+    EventQueueEntry *eventQueue;
+    int eventQueueTop;
+    int stringCount;
+    char **strings;
+    int setCount;
+    Set **sets;
+} RememberedState;
+
+
 /* PRIVATE DATA */
 static GameState gameState;     /* TODO: Make pointer, then we don't have to copy to stack, we can just use the pointer */
 static StateStackP stateStack = NULL;
+static RememberedState remembered;
+static unsigned long undoMemory = 0; /* Memory used by all stacked states */
 
 static char *playerCommand;
 
@@ -65,16 +115,6 @@ static int countStrings(void) {
 }
 
 
-/*----------------------------------------------------------------------*/
-static void deallocateStrings(GameState *gameState) {
-    int count = countStrings();
-    int i;
-
-    for (i = 0; i < count; i++)
-        deallocate(gameState->strings[i]);
-    deallocate(gameState->strings);
-}
-
 /*----------------------------------------------------------------------*/
 static int countSets(void) {
     SetInitEntry *entry;
@@ -88,149 +128,377 @@ static int countSets(void) {
 
 
 /*----------------------------------------------------------------------*/
-static void deallocateSets(GameState *gameState) {
-    int count = countSets();
-    int i;
+static char *currentString(int index) {
+    StringInitEntry *entry = pointerTo(header->stringInitTable);
+    return fromAptr(getAttribute(admin[entry[index].instanceCode].attributes, entry[index].attributeCode));
+}
+
 
-    for (i = 0; i < count; i++)
-        freeSet(gameState->sets[i]);
-    deallocate(gameState->sets);
+/*----------------------------------------------------------------------*/
+static Set *currentSet(int index) {
+    SetInitEntry *entry = pointerTo(header->setInitTable);
+    return fromAptr(getAttribute(admin[entry[index].instanceCode].attributes, entry[index].attributeCode));
 }
 
-/*======================================================================*/
-void deallocateGameState(GameState *gameState) {
 
-    deallocate(gameState->admin);
-    deallocate(gameState->attributes);
+/*----------------------------------------------------------------------*/
+static Aword *currentArea(Area area) {
+    switch (area) {
+    case ADMIN_AREA: return (Aword *)admin;
+    case ATTRIBUTE_AREA: return (Aword *)attributes;
+    case SCORE_AREA: return scores;
+    default: syserr("Unexpected area in currentArea()");
+    }
+    return NULL;
+}
 
-    if (gameState->eventQueueTop > 0) {
-        deallocate(gameState->eventQueue);
-        gameState->eventQueue = NULL;
+
+/*----------------------------------------------------------------------*/
+static int currentAreaSize(Area area) {
+    switch (area) {
+    case ADMIN_AREA: return (header->instanceMax+1)*sizeof(AdminEntry)/sizeof(Aword);
+    case ATTRIBUTE_AREA: return header->attributesAreaSize;
+    case SCORE_AREA: return scores == NULL? 0 : header->scoreCount;
+    default: syserr("Unexpected area in currentAreaSize()");
     }
-    if (gameState->scores)
-        deallocate(gameState->scores);
+    return 0;
+}
 
-    deallocateStrings(gameState);
-    deallocateSets(gameState);
 
-    memset(gameState, 0, sizeof(GameState));
+/*----------------------------------------------------------------------*/
+/* Sets are compared member by member, in order, since the order is
+   visible to the game when iterating over them */
+static bool identicalSets(Set *set1, Set *set2) {
+    if (set1->size != set2->size)
+        return false;
+    return set1->size == 0
+        || memcmp(set1->members, set2->members, set1->size*sizeof(set1->members[0])) == 0;
 }
 
 
-/*======================================================================*/
-void forgetGameState(void) {
-    char *playerCommand;
-    popGameState(stateStack, &gameState, &playerCommand);
-    deallocateGameState(&gameState);
-    if (playerCommand != NULL)
-        deallocate(playerCommand);
+/*----------------------------------------------------------------------*/
+static unsigned long setMemory(Set *set) {
+    return sizeof(Set) + set->allocated*sizeof(set->members[0]);
 }
 
 
-/*======================================================================*/
-void initStateStack(void) {
-    if (stateStack != NULL)
-        deleteStateStack(stateStack);
-    stateStack = createStateStack(sizeof(GameState));
+/*----------------------------------------------------------------------*/
+static void forgetRememberedState(void) {
+    int i;
+
+    for (i = 0; i < AREA_COUNT; i++)
+        if (remembered.area[i] != NULL)
+            deallocate(remembered.area[i]);
+    if (remembered.eventQueue != NULL)
+        deallocate(remembered.eventQueue);
+    for (i = 0; i < remembered.stringCount; i++)
+        deallocate(remembered.strings[i]);
+    if (remembered.strings != NULL)
+        deallocate(remembered.strings);
+    for (i = 0; i < remembered.setCount; i++)
+        freeSet(remembered.sets[i]);
+    if (remembered.sets != NULL)
+        deallocate(remembered.sets);
+
+    memset(&remembered, 0, sizeof(remembered));
 }
 
 
-/*======================================================================*/
-void terminateStateStack(void) {
-    deleteStateStack(stateStack);
-    stateStack = NULL;
+/*----------------------------------------------------------------------*/
+static void rememberWholeState(void) {
+    int i;
+
+    forgetRememberedState();
+
+    for (i = 0; i < AREA_COUNT; i++) {
+        remembered.areaSize[i] = currentAreaSize(i);
+        if (remembered.areaSize[i] > 0)
+            remembered.area[i] = duplicate(currentArea(i), remembered.areaSize[i]*sizeof(Aword));
+    }
+
+    remembered.score = current.score;
+
+    remembered.eventQueueTop = eventQueueTop;
+    if (eventQueueTop > 0)
+        remembered.eventQueue = duplicate(eventQueue, eventQueueTop*sizeof(EventQueueEntry));
+
+    remembered.stringCount = countStrings();
+    if (remembered.stringCount > 0) {
+        remembered.strings = allocate(remembered.stringCount*sizeof(char *));
+        for (i = 0; i < remembered.stringCount; i++)
+            remembered.strings[i] = strdup(currentString(i));
+    }
+
+    remembered.setCount = countSets();
+    if (remembered.setCount > 0) {
+        remembered.sets = allocate(remembered.setCount*sizeof(Set *));
+        for (i = 0; i < remembered.setCount; i++)
+            remembered.sets[i] = copySet(currentSet(i));
+    }
+
+    remembered.valid = true;
 }
 
 
-/*======================================================================*/
-bool anySavedState(void) {
-    return !stateStackIsEmpty(stateStack);
+/*----------------------------------------------------------------------*/
+static void recordWordChanges(GameState *state) {
+    int area, i, count = 0;
+
+    for (area = 0; area < AREA_COUNT; area++) {
+        Aword *now = currentArea(area);
+        Aword *before = remembered.area[area];
+        for (i = 0; i < remembered.areaSize[area]; i++)
+            if (now[i] != before[i])
+                count++;
+    }
+    if (count == 0)
+        return;
+
+    state->wordChanges = allocate(count*sizeof(WordChange));
+    for (area = 0; area < AREA_COUNT; area++) {
+        Aword *now = currentArea(area);
+        Aword *before = remembered.area[area];
+        for (i = 0; i < remembered.areaSize[area]; i++)
+            if (now[i] != before[i]) {
+                WordChange *change = &state->wordChanges[state->wordChangeCount++];
+                change->area = area;
+                change->index = i;
+                change->value = before[i];
+                before[i] = now[i];
+            }
+    }
+    state->size += count*sizeof(WordChange);
 }
 
 
 /*----------------------------------------------------------------------*/
-static Set **collectSets(void) {
-    SetInitEntry *entry;
-    int count = countSets();
-    Set **sets;
+static void recordStringChanges(GameState *state) {
     int i;
 
-    if (count == 0) return NULL;
+    for (i = 0; i < remembered.stringCount; i++) {
+        char *now = currentString(i);
+        if (strcmp(now, remembered.strings[i]) != 0) {
+            StringChange *change;
+            state->stringChanges = realloc(state->stringChanges, (state->stringChangeCount+1)*sizeof(StringChange));
+            if (state->stringChanges == NULL)
+                syserr("Out of memory in 'recordStringChanges()'");
+            change = &state->stringChanges[state->stringChangeCount++];
+            change->index = i;
+            change->value = remembered.strings[i];
+            remembered.strings[i] = strdup(now);
+            state->size += sizeof(StringChange) + strlen(change->value) + 1;
+        }
+    }
+}
 
-    sets = allocate(count*sizeof(Set));
 
-    entry = pointerTo(header->setInitTable);
-    for (i = 0; i < count; i++)
-        sets[i] = getInstanceSetAttribute(entry[i].instanceCode, entry[i].attributeCode);
+/*----------------------------------------------------------------------*/
+static void recordSetChanges(GameState *state) {
+    int i;
 
-    return sets;
+    for (i = 0; i < remembered.setCount; i++) {
+        Set *now = currentSet(i);
+        if (!identicalSets(now, remembered.sets[i])) {
+            SetChange *change;
+            state->setChanges = realloc(state->setChanges, (state->setChangeCount+1)*sizeof(SetChange));
+            if (state->setChanges == NULL)
+                syserr("Out of memory in 'recordSetChanges()'");
+            change = &state->setChanges[state->setChangeCount++];
+            change->index = i;
+            change->value = remembered.sets[i];
+            remembered.sets[i] = copySet(now);
+            state->size += sizeof(SetChange) + setMemory(change->value);
+        }
+    }
 }
 
 
 /*----------------------------------------------------------------------*/
-static char **collectStrings(void) {
-    StringInitEntry *entry;
-    int count = countStrings();
-    char **strings;
+static void recordEventChanges(GameState *state) {
+    if (eventQueueTop == remembered.eventQueueTop
+        && (eventQueueTop == 0
+            || memcmp(eventQueue, remembered.eventQueue, eventQueueTop*sizeof(EventQueueEntry)) == 0))
+        return;
+
+    state->eventsChanged = true;
+    state->eventQueue = remembered.eventQueue;
+    state->eventQueueTop = remembered.eventQueueTop;
+    state->size += state->eventQueueTop*sizeof(EventQueueEntry);
+
+    remembered.eventQueueTop = eventQueueTop;
+    if (eventQueueTop > 0)
+        remembered.eventQueue = duplicate(eventQueue, eventQueueTop*sizeof(EventQueueEntry));
+    else
+        remembered.eventQueue = NULL;
+}
+
+
+/*----------------------------------------------------------------------*/
+/* Record how the current state differs from the remembered one, and
+   make the current state the remembered one */
+static void recordChanges(GameState *state) {
+    memset(state, 0, sizeof(GameState));
+    state->size = sizeof(GameState);
+
+    state->score = remembered.score;
+    remembered.score = current.score;
+
+    recordWordChanges(state);
+    recordStringChanges(state);
+    recordSetChanges(state);
+    recordEventChanges(state);
+}
+
+
+/*----------------------------------------------------------------------*/
+/* Step the remembered state back to the state below 'state' on the
+   stack. The old values are moved from 'state' into the remembered
+   state, so what remains in 'state' can simply be deallocated. */
+static void revertRememberedState(GameState *state) {
     int i;
 
-    if (count == 0) return NULL;
+    for (i = 0; i < state->wordChangeCount; i++) {
+        WordChange *change = &state->wordChanges[i];
+        remembered.area[change->area][change->index] = change->value;
+    }
+
+    for (i = 0; i < state->stringChangeCount; i++) {
+        StringChange *change = &state->stringChanges[i];
+        deallocate(remembered.strings[change->index]);
+        remembered.strings[change->index] = change->value;
+        change->value = NULL;
+    }
 
-    strings = allocate(count*sizeof(char *));
+    for (i = 0; i < state->setChangeCount; i++) {
+        SetChange *change = &state->setChanges[i];
+        freeSet(remembered.sets[change->index]);
+        remembered.sets[change->index] = change->value;
+        change->value = NULL;
+    }
 
-    entry = pointerTo(header->stringInitTable);
-    for (i = 0; i < count; i++)
-        strings[i] = getInstanceStringAttribute(entry[i].instanceCode, entry[i].attributeCode);
+    if (state->eventsChanged) {
+        if (remembered.eventQueue != NULL)
+            deallocate(remembered.eventQueue);
+        remembered.eventQueue = state->eventQueue;
+        remembered.eventQueueTop = state->eventQueueTop;
+        state->eventQueue = NULL;
+    }
 
-    return strings;
+    remembered.score = state->score;
 }
 
 
 /*======================================================================*/
-void rememberCommands(void) {
-    char *command = playerWordsAsCommandString();
-    attachPlayerCommandsToLastState(stateStack, command);
-    deallocate(command);
+void deallocateGameState(GameState *gameState) {
+    int i;
+
+    if (gameState->wordChanges != NULL)
+        deallocate(gameState->wordChanges);
+
+    for (i = 0; i < gameState->stringChangeCount; i++)
+        if (gameState->stringChanges[i].value != NULL)
+            deallocate(gameState->stringChanges[i].value);
+    if (gameState->stringChanges != NULL)
+        deallocate(gameState->stringChanges);
+
+    for (i = 0; i < gameState->setChangeCount; i++)
+        freeSet(gameState->setChanges[i].value);
+    if (gameState->setChanges != NULL)
+        deallocate(gameState->setChanges);
+
+    if (gameState->eventQueue != NULL)
+        deallocate(gameState->eventQueue);
+
+    memset(gameState, 0, sizeof(GameState));
 }
 
 
 /*----------------------------------------------------------------------*/
-static void collectEvents(void) {
-    gameState.eventQueueTop = eventQueueTop;
-    if (eventQueueTop > 0)
-        gameState.eventQueue = duplicate(eventQueue, eventQueueTop*sizeof(EventQueueEntry));
+static void popAndRevert(void) {
+    popGameState(stateStack, &gameState, &playerCommand);
+    undoMemory -= gameState.size;
+    if (stateStackIsEmpty(stateStack))
+        forgetRememberedState();
+    else
+        revertRememberedState(&gameState);
+    deallocateGameState(&gameState);
 }
 
 
-/*----------------------------------------------------------------------*/
-static void collectInstanceData(void) {
-    gameState.admin = duplicate(admin, (header->instanceMax+1)*sizeof(AdminEntry));
-    gameState.attributes = duplicate(attributes, header->attributesAreaSize*sizeof(Aword));
-    gameState.sets = collectSets();
-    gameState.strings = collectStrings();
+/*======================================================================*/
+void forgetGameState(void) {
+    popAndRevert();
+    if (playerCommand != NULL)
+        deallocate(playerCommand);
+    playerCommand = NULL;
+}
+
+
+/*======================================================================*/
+void initStateStack(void) {
+    if (stateStack != NULL)
+        deleteStateStack(stateStack);
+    stateStack = createStateStack(sizeof(GameState));
+    forgetRememberedState();
+    undoMemory = 0;
+}
+
+
+/*======================================================================*/
+void terminateStateStack(void) {
+    deleteStateStack(stateStack);
+    stateStack = NULL;
+    forgetRememberedState();
+    undoMemory = 0;
+}
+
+
+/*======================================================================*/
+bool anySavedState(void) {
+    return !stateStackIsEmpty(stateStack);
+}
+
+
+/*======================================================================*/
+void rememberCommands(void) {
+    char *command = playerWordsAsCommandString();
+    attachPlayerCommandsToLastState(stateStack, command);
+    deallocate(command);
 }
 
 
 /*----------------------------------------------------------------------*/
-static void collectScores(void) {
-    gameState.score = current.score;
-    if (scores == NULL)
-        gameState.scores = NULL;
-    else
-        gameState.scores = duplicate(scores, header->scoreCount*sizeof(Aword));
+/* Drop the oldest states until the stack fits within the memory
+   limit, always keeping the two newest so that one undo is possible */
+static void limitUndoMemory(void) {
+    GameState oldest;
+    char *command;
+
+    while (undoMemory > UNDO_MEMORY_LIMIT && stateStackDepth(stateStack) > 2) {
+        dropOldestGameState(stateStack, &oldest, &command);
+        undoMemory -= oldest.size;
+        deallocateGameState(&oldest);
+        if (command != NULL)
+            deallocate(command);
+    }
 }
 
 
 /*======================================================================*/
 void rememberGameState(void) {
-    collectEvents();
-    collectInstanceData();
-    collectScores();
-
     if (stateStack == NULL)
         initStateStack();
 
+    if (stateStackIsEmpty(stateStack) || !remembered.valid) {
+        rememberWholeState();
+        memset(&gameState, 0, sizeof(GameState));
+        gameState.size = sizeof(GameState);
+    } else
+        recordChanges(&gameState);
+
     pushGameState(stateStack, &gameState);
+    undoMemory += gameState.size;
+    limitUndoMemory();
     gameStateChanged = false;
 }
 
@@ -248,18 +516,16 @@ static void freeCurrentSetAttributes(void) {
 
 
 /*----------------------------------------------------------------------*/
-static void recallSets(Set **sets) {
+static void recallSets(void) {
     SetInitEntry *entry;
-    int count = countSets();
     int i;
 
     if (header->setInitTable == 0) return;
 
     entry = pointerTo(header->setInitTable);
-    for (i = 0; i < count; i++) {
-        setAttribute(admin[entry[i].instanceCode].attributes, entry[i].attributeCode, toAptr(sets[i]));
-        sets[i] = NULL; /* Since we reuse the saved set, we need to clear the pointer */
-    }
+    for (i = 0; i < remembered.setCount; i++)
+        setAttribute(admin[entry[i].instanceCode].attributes, entry[i].attributeCode,
+                     toAptr(copySet(remembered.sets[i])));
 }
 
 
@@ -276,27 +542,25 @@ static void freeCurrentStringAttributes(void) {
 
 
 /*----------------------------------------------------------------------*/
-static void recallStrings(char **strings) {
+static void recallStrings(void) {
     StringInitEntry *entry;
-    int count = countStrings();
     int i;
 
     if (header->stringInitTable == 0) return;
 
     entry = pointerTo(header->stringInitTable);
-    for (i = 0; i < count; i++) {
-        setAttribute(admin[entry[i].instanceCode].attributes, entry[i].attributeCode, toAptr(strings[i]));
-        strings[i] = NULL;      /* Since we reuse the saved, we need to clear the state */
-    }
+    for (i = 0; i < remembered.stringCount; i++)
+        setAttribute(admin[entry[i].instanceCode].attributes, entry[i].attributeCode,
+                     toAptr(strdup(remembered.strings[i])));
 }
 
 
 /*----------------------------------------------------------------------*/
 static void recallEvents(void) {
-    eventQueueTop = gameState.eventQueueTop;
+    eventQueueTop = remembered.eventQueueTop;
     if (eventQueueTop > 0) {
-        memcpy(eventQueue, gameState.eventQueue,
-               (eventQueueTop+1)*sizeof(EventQueueEntry));
+        memcpy(eventQueue, remembered.eventQueue,
+               eventQueueTop*sizeof(EventQueueEntry));
     }
 }
 
@@ -307,34 +571,39 @@ static void recallInstances(void) {
     if (admin == NULL)
         syserr("admin[] == NULL in recallInstances()");
 
-    memcpy(admin, gameState.admin,
-           (header->instanceMax+1)*sizeof(AdminEntry));
+    memcpy(admin, remembered.area[ADMIN_AREA],
+           remembered.areaSize[ADMIN_AREA]*sizeof(Aword));
 
     freeCurrentSetAttributes();		/* Need to free previous set values */
     freeCurrentStringAttributes();	/* Need to free previous string values */
 
-    memcpy(attributes, gameState.attributes,
-           header->attributesAreaSize*sizeof(Aword));
+    /* The string and set pointers copied here are stale, recallSets()
+       and recallStrings() replace them with fresh copies */
+    memcpy(attributes, remembered.area[ATTRIBUTE_AREA],
+           remembered.areaSize[ATTRIBUTE_AREA]*sizeof(Aword));
 
-    recallSets(gameState.sets);
-    recallStrings(gameState.strings);
+    recallSets();
+    recallStrings();
 }
 
 
 /*----------------------------------------------------------------------*/
 static void recallScores(void) {
-    current.score = gameState.score;
-    memcpy(scores, gameState.scores, header->scoreCount*sizeof(Aword));
+    current.score = remembered.score;
+    if (remembered.areaSize[SCORE_AREA] > 0)
+        memcpy(scores, remembered.area[SCORE_AREA],
+               remembered.areaSize[SCORE_AREA]*sizeof(Aword));
 }
 
 
 /*======================================================================*/
 void recallGameState(void) {
-    popGameState(stateStack, &gameState, &playerCommand);
+    /* The remembered state is the one on top of the stack, so restore
+       that and then pop it */
     recallEvents();
     recallInstances();
     recallScores();
-    deallocateGameState(&gameState);
+    popAndRevert();
 }
 
 
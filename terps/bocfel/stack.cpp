@@ -16,15 +16,20 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -86,15 +91,18 @@ static uint16_t pop_stack()
     return *--sp;
 }
 
+// The Quetzal data of a save state never changes once created, and is
+// shared, so that autosaves can hold on to it while being written out
+// on another thread.
 struct SaveState {
 public:
     SaveType savetype;
-    std::vector<uint8_t> quetzal;
+    std::shared_ptr<const std::vector<uint8_t>> quetzal;
     std::string desc;
 
     SaveState(SaveType savetype_, const char *desc_, std::vector<uint8_t> quetzal_) :
         savetype(savetype_),
-        quetzal(std::move(quetzal_)),
+        quetzal(std::make_shared<const std::vector<uint8_t>>(std::move(quetzal_))),
         desc(desc_ == nullptr ? format_time() : desc_)
     {
     }
@@ -628,14 +636,12 @@ static IFF::TypeID write_args(IO &savefile, SaveOpcode saveopcode)
     return IFF::TypeID(&"Args");
 }
 
-static void write_undo_msav(IO &savefile, SaveStackType type)
+static void write_undo_msav(IO &savefile, const std::deque<SaveState> &states, SaveStackType type)
 {
-    SaveStack &s = save_stacks[type];
-
     savefile.write32(0); // Version
-    savefile.write32(s.states.size());
+    savefile.write32(states.size());
 
-    for (auto state = s.states.crbegin(); state != s.states.crend(); ++state) {
+    for (auto state = states.crbegin(); state != states.crend(); ++state) {
         if (type == SaveStackType::Game) {
             savefile.write8(static_cast<uint8_t>(state->savetype));
         } else if (type == SaveStackType::User) {
@@ -647,21 +653,21 @@ static void write_undo_msav(IO &savefile, SaveStackType type)
             }
         }
 
-        savefile.write32(state->quetzal.size());
-        savefile.write_exact(state->quetzal.data(), state->quetzal.size());
+        savefile.write32(state->quetzal->size());
+        savefile.write_exact(state->quetzal->data(), state->quetzal->size());
     }
 }
 
-static IFF::TypeID write_undo(IO &savefile)
+static IFF::TypeID write_undo(IO &savefile, const std::deque<SaveState> *states)
 {
-    write_undo_msav(savefile, SaveStackType::Game);
+    write_undo_msav(savefile, *states, SaveStackType::Game);
 
     return IFF::TypeID(&"Undo");
 }
 
-static IFF::TypeID write_msav(IO &savefile)
+static IFF::TypeID write_msav(IO &savefile, const std::deque<SaveState> *states)
 {
-    write_undo_msav(savefile, SaveStackType::User);
+    write_undo_msav(savefile, *states, SaveStackType::User);
 
     return IFF::TypeID(&"MSav");
 }
@@ -736,9 +742,9 @@ static bool save_quetzal(IO &savefile, SaveType savetype, SaveOpcode saveopcode,
             write_chunk(savefile, screen_write_scrn);
         }
 
+        // The Undo and MSav chunks of autosaves are appended by the
+        // autosave writer (see below), so they must come last.
         if (savetype == SaveType::Autosave) {
-            write_chunk(savefile, write_undo);
-            write_chunk(savefile, write_msav);
             write_chunk(savefile, random_write_rand);
         }
 
@@ -1218,10 +1224,200 @@ static std::shared_ptr<IO> open_savefile(SaveType savetype, IO::Mode mode)
     }
 }
 
+// Autosaves happen before every read, so writing them out, including
+// every state on the undo and in-memory save stacks, is done on a
+// background thread. The interpreter only captures a snapshot: the
+// Quetzal data (apart from the Undo and MSav chunks) in memory, plus
+// references to the current save states. The writer appends the save
+// states, writes everything to a temporary file, and renames it over
+// the autosave, so an interrupted write never leaves a truncated
+// autosave behind. If a snapshot arrives while the writer is busy, it
+// replaces any snapshot still waiting, since only the latest matters.
+struct AutosaveJob {
+    std::string filename;
+    std::vector<uint8_t> quetzal;
+    std::deque<SaveState> undo;
+    std::deque<SaveState> msav;
+};
+
+static bool write_autosave(const AutosaveJob &job)
+{
+    std::string tmpname = job.filename + ".tmp";
+
+    try {
+        IO savefile(&tmpname, IO::Mode::WriteOnly, IO::Purpose::Save);
+        long file_size;
+
+        savefile.write_exact(job.quetzal.data(), job.quetzal.size());
+        write_chunk(savefile, write_undo, &job.undo);
+        write_chunk(savefile, write_msav, &job.msav);
+
+        file_size = savefile.tell();
+        savefile.seek(4, IO::SeekFrom::Start);
+        savefile.write32(file_size - 8);
+        savefile.flush();
+    } catch (const IO::OpenError &) {
+        // As with synchronous autosaves, an autosave file that cannot be
+        // opened is silently ignored.
+        return true;
+    } catch (const IO::IOError &) {
+        std::remove(tmpname.c_str());
+        return false;
+    }
+
+    // Windows will not rename over an existing file.
+    if (std::rename(tmpname.c_str(), job.filename.c_str()) == -1) {
+        std::remove(job.filename.c_str());
+        if (std::rename(tmpname.c_str(), job.filename.c_str()) == -1) {
+            std::remove(tmpname.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+class AutosaveWriter {
+public:
+    AutosaveWriter() = default;
+    AutosaveWriter(const AutosaveWriter &) = delete;
+    AutosaveWriter &operator=(const AutosaveWriter &) = delete;
+
+    // Any pending autosave is written before the writer goes away.
+    ~AutosaveWriter() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_cond.notify_all();
+
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void submit(std::unique_ptr<AutosaveJob> job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_thread.joinable()) {
+                try {
+                    m_thread = std::thread(&AutosaveWriter::run, this);
+                } catch (const std::system_error &) {
+                    // No thread available: write synchronously.
+                    if (!write_autosave(*job)) {
+                        m_failed = true;
+                    }
+                    return;
+                }
+            }
+
+            m_pending = std::move(job);
+        }
+        m_cond.notify_all();
+    }
+
+    // Wait until there is no pending or in-progress autosave.
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return m_pending == nullptr && !m_busy; });
+    }
+
+    // Returns true if a write failed since the last call.
+    bool failed() {
+        return m_failed.exchange(false);
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true) {
+            m_cond.wait(lock, [this] { return m_quit || m_pending != nullptr; });
+            if (m_pending == nullptr) {
+                return;
+            }
+
+            auto job = std::move(m_pending);
+            m_busy = true;
+            lock.unlock();
+
+            bool success = write_autosave(*job);
+            job.reset();
+
+            lock.lock();
+            m_busy = false;
+            if (!success) {
+                m_failed = true;
+            }
+            m_cond.notify_all();
+        }
+    }
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::unique_ptr<AutosaveJob> m_pending;
+    bool m_busy = false;
+    bool m_quit = false;
+    std::atomic<bool> m_failed{false};
+};
+
+static AutosaveWriter &autosave_writer()
+{
+    static AutosaveWriter writer;
+
+    return writer;
+}
+
+void wait_for_autosave()
+{
+    autosave_writer().wait();
+}
+
+static bool do_autosave(SaveOpcode saveopcode)
+{
+    auto filename = zterp_os_autosave_name();
+    if (filename == nullptr) {
+        return false;
+    }
+
+    if (autosave_writer().failed()) {
+        warning("error while writing save file");
+    }
+
+    try {
+        auto job = std::make_unique<AutosaveJob>();
+        IO savefile(std::vector<uint8_t>(), IO::Mode::WriteOnly);
+
+        if (!save_quetzal(savefile, SaveType::Autosave, saveopcode, true)) {
+            warning("error while writing save file");
+            return false;
+        }
+
+        job->filename = *filename;
+        job->quetzal = savefile.get_memory();
+        job->undo = save_stacks[SaveStackType::Game].states;
+        job->msav = save_stacks[SaveStackType::User].states;
+
+        autosave_writer().submit(std::move(job));
+    } catch (const IO::OpenError &) {
+        return false;
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+
+    return true;
+}
+
 // Perform all aspects of a save, apart from storing/branching.
 // Returns true if the save was success, false if not.
 bool do_save(SaveType savetype, SaveOpcode saveopcode)
 {
+    if (savetype == SaveType::Autosave) {
+        return do_autosave(saveopcode);
+    }
+
     auto savefile = open_savefile(savetype, IO::Mode::WriteOnly);
     if (savefile == nullptr) {
         return false;
@@ -1363,7 +1559,7 @@ bool pop_save(SaveStackType type, size_t saveno, SaveOpcode &saveopcode)
     s.states.pop_front();
 
     try {
-        savefile = std::make_shared<IO>(p.quetzal, IO::Mode::ReadOnly);
+        savefile = std::make_shared<IO>(*p.quetzal, IO::Mode::ReadOnly);
     } catch (const IO::OpenError &) {
         return false;
     }
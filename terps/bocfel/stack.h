@@ -44,6 +44,7 @@ enum class SaveOpcode {
 };
 
 bool do_save(SaveType savetype, SaveOpcode saveopcode);
+void wait_for_autosave();
 bool do_restore(SaveType savetype, SaveOpcode &saveopcode);
 
 enum class SaveStackType {
@@ -881,6 +881,9 @@ void zquit()
     // restore accidentally-deleted files. If the rename fails, though,
     // just try to delete it.
     if (options.autosave) {
+        // Don't let a pending autosave recreate the file afterwards.
+        wait_for_autosave();
+
         auto autosave_name = zterp_os_autosave_name();
         if (autosave_name != nullptr) {
             std::string backup_name = *autosave_name;
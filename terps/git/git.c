@@ -123,6 +123,20 @@ void gitWithStream (strid_t str, git_uint32 cacheSize, git_uint32 undoSize)
         giblorb_result_t result = handleBlorb (str);
         gamePos = result.data.startpos;
         gameSize = result.length;
+
+#ifdef GARGLK
+        // If Gargoyle has the Blorb file mapped into memory, run the
+        // game straight out of the mapping instead of copying it.
+        if (giblorb_is_mapped (giblorb_get_resource_map()))
+        {
+            giblorb_result_t mapped;
+            if (giblorb_load_resource (giblorb_get_resource_map(), giblorb_method_Memory, &mapped, giblorb_ID_Exec, 0) == giblorb_err_None)
+            {
+                gitMain ((const git_uint8 *) mapped.data.ptr, mapped.length, cacheSize, undoSize);
+                return;
+            }
+        }
+#endif
     }
     else
     {
@@ -4,6 +4,7 @@
 // Designed by Andrew Plotkin <erkyrath@eblong.com>
 // http://www.eblong.com/zarf/glulx/index.html
 
+#include <string.h>
 #include "glk.h"
 #include "git.h"
 #include "opcodes.h"
@@ -48,6 +49,19 @@
 
 static void fetchkey(unsigned char *keybuf, glui32 key, glui32 keysize, 
   glui32 options);
+static glui32 structs_in_memory(glui32 start, glui32 structsize,
+  glui32 numstructs, glui32 keyoffset, glui32 keysize);
+static glui32 scan_structs(unsigned char *keybuf, glui32 key, glui32 keysize,
+  glui32 start, glui32 structsize, glui32 numstructs, glui32 keyoffset,
+  int zeroterm, int *matched);
+
+/* The fast paths below read keys straight out of gMem, without going
+   through memRead8() for every byte. They are only taken when the keys
+   they touch are known to lie within memory, so out-of-range searches
+   still reach the byte-at-a-time code (and its error checks) exactly as
+   before. Keys of one, two, or four bytes are compared as integers;
+   longer (indirect) keys are compared with memcmp(), which the C
+   library vectorizes. */
 
 /* linear_search():
    An array of data structures is stored in memory, beginning at start,
@@ -76,7 +90,32 @@ glui32 git_linear_search(glui32 key, glui32 keysize,
 
   fetchkey(keybuf, key, keysize, options);
 
-  for (count=0; count<numstructs; count++, start+=structsize) {
+  count = 0;
+  if (keysize != 0 
+    && (keysize <= 4 || structs_in_memory(key, 0, 1, 0, keysize))) {
+    glui32 avail = structs_in_memory(start, structsize, numstructs,
+      keyoffset, keysize);
+    if (avail) {
+      int matched;
+      count = scan_structs(keybuf, key, keysize, start, structsize, avail,
+	keyoffset, zeroterm, &matched);
+      if (count < avail) {
+	if (!matched) {
+	  if (retindex)
+	    return -1;
+	  else
+	    return 0;
+	}
+	if (retindex)
+	  return count;
+	else
+	  return start + count * structsize;
+      }
+      start += avail * structsize;
+    }
+  }
+
+  for (; count<numstructs; count++, start+=structsize) {
     int match = TRUE;
     if (keysize <= 4) {
       for (ix=0; match && ix<keysize; ix++) {
@@ -187,12 +226,46 @@ static glui32 binary_search_generic(glui32 key, glui32 keysize,
     return 0;
 }
 
+static glui32 binary_search_8bit(git_uint8 key, glui32 start,
+  glui32 structsize, glui32 numstructs,
+  glui32 keyoffset, glui32 options)
+{
+  glui32 addr, top, bot, val;
+  git_uint8 m;
+  int less;
+  int retindex = ((options & serop_ReturnIndex) != 0);
+
+  bot = 0;
+  top = numstructs;
+  while (bot < top) {
+    val = (top+bot) / 2;
+    addr = start + val * structsize;
+
+    m = memRead8(addr + keyoffset);
+    if (m == key) {
+      if (retindex)
+	return val;
+      else
+	return addr;
+    }
+    less = (m < key);
+    bot = less ? val + 1 : bot;
+    top = less ? top : val;
+  }
+
+  if (retindex)
+    return -1;
+  else
+    return 0;
+}
+
 static glui32 binary_search_16bit(git_uint16 key, glui32 start,
   glui32 structsize, glui32 numstructs,
   glui32 keyoffset, glui32 options)
 {
   glui32 addr, top, bot, val;
   git_uint16 m;
+  int less;
   int retindex = ((options & serop_ReturnIndex) != 0);
 
   bot = 0;
@@ -207,11 +280,10 @@ static glui32 binary_search_16bit(git_uint16 key, glui32 start,
 	return val;
       else
 	return addr;
-    } else if (m < key) {
-      bot = val + 1;
-    } else {
-      top = val;
     }
+    less = (m < key);
+    bot = less ? val + 1 : bot;
+    top = less ? top : val;
   }
 
   if (retindex)
@@ -225,6 +297,7 @@ static glui32 binary_search_32bit(git_uint32 key, glui32 start,
   glui32 keyoffset, glui32 options)
 {
   glui32 addr, top, bot, val, m;
+  int less;
   int retindex = ((options & serop_ReturnIndex) != 0);
 
   bot = 0;
@@ -239,11 +312,10 @@ static glui32 binary_search_32bit(git_uint32 key, glui32 start,
 	return val;
       else
 	return addr;
-    } else if (m < key) {
-      bot = val + 1;
-    } else {
-      top = val;
     }
+    less = (m < key);
+    bot = less ? val + 1 : bot;
+    top = less ? top : val;
   }
 
   if (retindex)
@@ -256,6 +328,15 @@ glui32 git_binary_search(glui32 key, glui32 keysize,
   glui32 start, glui32 structsize, glui32 numstructs,
   glui32 keyoffset, glui32 options)
 {
+  if (keysize == 1) {
+    git_uint8 key8;
+    if ((options & serop_KeyIndirect) != 0) {
+      key8 = memRead8(key);
+    } else {
+      key8 = key;
+    }
+    return binary_search_8bit(key8, start, structsize, numstructs, keyoffset, options);
+  }
   if (keysize == 2) {
     git_uint16 key16;
     if ((options & serop_KeyIndirect) != 0) {
@@ -289,14 +370,39 @@ glui32 git_linked_search(glui32 key, glui32 keysize,
   glui32 start, glui32 keyoffset, glui32 nextoffset, glui32 options)
 {
   unsigned char keybuf[4];
+  unsigned char *keyptr;
   int ix;
+  glui32 jx;
   glui32 val;
   int zeroterm = ((options & serop_ZeroKeyTerminates) != 0);
 
   fetchkey(keybuf, key, keysize, options);
 
+  /* keyptr is set if the nodes' keys can be compared with memcmp(). */
+  keyptr = NULL;
+  if (keysize != 0 && keysize <= 4)
+    keyptr = keybuf;
+  else if (keysize > 4 && structs_in_memory(key, 0, 1, 0, keysize))
+    keyptr = gMem + key;
+
   while (start != 0) {
     int match = TRUE;
+    if (keyptr && structs_in_memory(start, 0, 1, keyoffset, keysize)) {
+      unsigned char *ptr = gMem + (glui32)(start + keyoffset);
+      if (memcmp(ptr, keyptr, keysize) == 0)
+	return start;
+      if (zeroterm) {
+	for (jx=0; jx<keysize; jx++) {
+	  if (ptr[jx] != 0)
+	    break;
+	}
+	if (jx == keysize)
+	  break;
+      }
+      val = start + nextoffset;
+      start = memRead32(val);
+      continue;
+    }
     if (keysize <= 4) {
       for (ix=0; match && ix<keysize; ix++) {
 	if (memRead8(start + keyoffset + ix) != keybuf[ix])
@@ -364,3 +470,109 @@ static void fetchkey(unsigned char *keybuf, glui32 key, glui32 keysize,
     }
   }
 }
+
+/* structs_in_memory():
+   Count how many of the numstructs structs beginning at start (at most)
+   have their entire key within the current memory map. Addresses wrap
+   around at 32 bits, just as they do for memRead8().
+*/
+static glui32 structs_in_memory(glui32 start, glui32 structsize,
+  glui32 numstructs, glui32 keyoffset, glui32 keysize)
+{
+  glui32 addr = start + keyoffset;
+  glui32 avail;
+
+  if (addr >= gEndMem || gEndMem - addr < keysize)
+    return 0;
+  if (structsize == 0)
+    return numstructs;
+  avail = (gEndMem - addr - keysize) / structsize + 1;
+  return (avail < numstructs) ? avail : numstructs;
+}
+
+/* scan_structs():
+   The inner loop of linear_search(), for numstructs structs which are
+   all known to be in memory (see structs_in_memory()). Returns the index
+   of the first struct whose key matches, or (if zeroterm is set) whose
+   key is all zeroes; *matched says which it was. If neither is found,
+   returns numstructs.
+*/
+static glui32 scan_structs(unsigned char *keybuf, glui32 key, glui32 keysize,
+  glui32 start, glui32 structsize, glui32 numstructs, glui32 keyoffset,
+  int zeroterm, int *matched)
+{
+  unsigned char *ptr = gMem + (glui32)(start + keyoffset);
+  unsigned char *keyptr;
+  glui32 count, keyval, zeroval, val = 0;
+  glui32 ix;
+
+  *matched = FALSE;
+
+  if (keysize == 1 && structsize == 1) {
+    /* A packed byte array, which memchr() can scan a word (or vector)
+       at a time. */
+    unsigned char *found = memchr(ptr, keybuf[0], numstructs);
+    if (found)
+      numstructs = found - ptr;
+    if (zeroterm && keybuf[0] != 0) {
+      unsigned char *zero = memchr(ptr, 0, numstructs);
+      if (zero)
+	return zero - ptr;
+    }
+    *matched = (found != NULL);
+    return numstructs;
+  }
+
+  /* For integer keys, a zero key stops the scan only if zeroterm is
+     set; otherwise zeroval is just the key again. A match always takes
+     precedence over a zero key. */
+  switch (keysize) {
+  case 4:
+    keyval = read32(keybuf);
+    zeroval = zeroterm ? 0 : keyval;
+    for (count=0; count<numstructs; count++, ptr+=structsize) {
+      val = read32(ptr);
+      if (val == keyval || val == zeroval)
+	break;
+    }
+    *matched = (count < numstructs && val == keyval);
+    return count;
+  case 2:
+    keyval = read16(keybuf);
+    zeroval = zeroterm ? 0 : keyval;
+    for (count=0; count<numstructs; count++, ptr+=structsize) {
+      val = read16(ptr);
+      if (val == keyval || val == zeroval)
+	break;
+    }
+    *matched = (count < numstructs && val == keyval);
+    return count;
+  case 1:
+    keyval = read8(keybuf);
+    zeroval = zeroterm ? 0 : keyval;
+    for (count=0; count<numstructs; count++, ptr+=structsize) {
+      val = read8(ptr);
+      if (val == keyval || val == zeroval)
+	break;
+    }
+    *matched = (count < numstructs && val == keyval);
+    return count;
+  }
+
+  keyptr = (keysize <= 4) ? keybuf : gMem + key;
+  for (count=0; count<numstructs; count++, ptr+=structsize) {
+    if (memcmp(ptr, keyptr, keysize) == 0) {
+      *matched = TRUE;
+      return count;
+    }
+    if (zeroterm) {
+      for (ix=0; ix<keysize; ix++) {
+	if (ptr[ix] != 0)
+	  break;
+      }
+      if (ix == keysize)
+	return count;
+    }
+  }
+  return numstructs;
+}
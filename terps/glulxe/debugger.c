@@ -1182,6 +1182,20 @@ static inforoutine *find_routine_for_address(glui32 addr)
     return func;
 }
 
+/* Return the name of the routine containing addr, and store its start
+   address in *funcaddr (if not NULL). If there is no debug info for
+   that address, return NULL. */
+const char *debugger_routine_for_address(glui32 addr, glui32 *funcaddr)
+{
+    inforoutine *func = find_routine_for_address(addr);
+    if (!func)
+        return NULL;
+
+    if (funcaddr)
+        *funcaddr = func->address;
+    return (const char *)func->identifier;
+}
+
 static void render_value_linebuf(glui32 val)
 {
     int tmplen;
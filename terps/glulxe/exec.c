@@ -45,6 +45,7 @@ void execute_loop()
 
     profile_tick();
     debugger_tick();
+    sample_tick();
     /* Do OS-specific processing, if appropriate. */
     glk_tick();
     
@@ -87,3 +87,35 @@ int locate_gamefile(int isblorb)
   }
 }
 
+
+#ifdef GARGLK
+
+/* gamefile_mapping():
+   If the game file is a Blorb file which Gargoyle has mapped into 
+   memory, return a pointer to the Glulx data (at gamefile_start) 
+   within the mapping. Otherwise return NULL; the game file stream 
+   should be read as usual.
+*/
+const unsigned char *gamefile_mapping()
+{
+  giblorb_err_t err;
+  giblorb_result_t blorbres;
+  giblorb_map_t *map = giblorb_get_resource_map();
+
+  if (!giblorb_is_mapped(map))
+    return NULL;
+
+  err = giblorb_load_resource(map, giblorb_method_FilePos, 
+    &blorbres, giblorb_ID_Exec, 0);
+  if (err || blorbres.data.startpos != gamefile_start
+    || blorbres.length < endgamefile)
+    return NULL;
+
+  err = giblorb_load_resource(map, giblorb_method_Memory, 
+    &blorbres, giblorb_ID_Exec, 0);
+  if (err)
+    return NULL;
+  return blorbres.data.ptr;
+}
+
+#endif /* GARGLK */
@@ -56,6 +56,14 @@ typedef int16_t glsi16;
    _BSD_SOURCE or _DEFAULT_SOURCE or both for the timeradd() macro.) */
 /* #define VM_PROFILING (1) */
 
+/* Uncomment this definition to compile in the sampling profiler. This
+   periodically records the VM call stack, and writes the results in the
+   "collapsed stack" format read by flame-graph tools. It does nothing
+   until it is switched on (with the "--sample" option, or at runtime by
+   a signal), so it can be left in release builds. It requires POSIX
+   signals and interval timers. */
+/* #define VM_SAMPLING (1) */
+
 /* Uncomment this definition to turn on the Glulx debugger. You should
    only do this when debugging facilities are desired; it slows down
    the interpreter. If you do, you will need to build with libxml2;
@@ -210,6 +218,9 @@ extern void nonfatal_warning_handler(char *str, char *arg, int useval, glsi32 va
 /* files.c */
 extern int is_gamefile_valid(void);
 extern int locate_gamefile(int isblorb);
+#ifdef GARGLK
+extern const unsigned char *gamefile_mapping(void);
+#endif /* GARGLK */
 
 /* vm.c */
 extern void setup_vm(void);
@@ -328,6 +339,25 @@ extern void profile_quit(void);
 #define profile_fail(reason)   (0)
 #define profile_quit()         (0)
 #endif /* VM_PROFILING */
+#if VM_SAMPLING
+#include <signal.h>
+extern volatile sig_atomic_t sample_pending;
+extern int sample_running;
+#define sample_tick() do { if (sample_pending) sample_take(); } while (0)
+#define sample_call(addr) do { if (sample_running) sample_note_call(addr); } while (0)
+extern void setup_sample(strid_t stream, char *filename);
+extern int init_sample(void);
+extern void sample_take(void);
+extern void sample_note_call(glui32 addr);
+extern void sample_forget_calls(void);
+extern void sample_quit(void);
+#else /* VM_SAMPLING */
+#define sample_tick()          (0)
+#define sample_call(addr)      (0)
+#define init_sample()          (TRUE)
+#define sample_forget_calls()  (0)
+#define sample_quit()          (0)
+#endif /* VM_SAMPLING */
 
 #if VM_DEBUGGER
 extern unsigned long debugger_opcount;
@@ -347,6 +377,7 @@ extern void debugger_check_func_breakpoint(glui32 addr);
 extern void debugger_block_and_debug(char *msg);
 extern void debugger_handle_crash(char *msg);
 extern void debugger_handle_quit(void);
+extern const char *debugger_routine_for_address(glui32 addr, glui32 *funcaddr);
 #else /* VM_DEBUGGER */
 #define debugger_tick()              (0)
 #define debugger_check_story_file()  (0)
@@ -63,6 +63,9 @@ void glk_main()
   if (!init_profile()) {
     return;
   }
+  if (!init_sample()) {
+    return;
+  }
 
   setup_vm();
   if (library_autorestore_hook)
@@ -77,6 +80,7 @@ void glk_main()
   vm_exited_cleanly = TRUE;
   
   profile_quit();
+  sample_quit();
   glk_exit();
 }
 
@@ -75,6 +75,9 @@ function generated by the compiler. Its total_time is the running time
 of the entire program; its total_ops is the number of opcodes executed
 by the entire program; its max_depth is zero.
 
+This file also contains a much lighter sampling profiler (VM_SAMPLING),
+which writes flame-graph input; see the comments further down.
+
  */
 
 #include "glk.h"
@@ -452,3 +455,367 @@ int init_profile()
 }
 
 #endif /* VM_PROFILING */
+
+#if VM_SAMPLING
+
+/* The sampling profiler. This is compiled separately from VM_PROFILING,
+   and it costs next to nothing while it is switched off, so it can be
+   left in ordinary builds.
+
+   While it is running, an interval timer (ITIMER_PROF, so only CPU
+   time counts) fires every millisecond. The signal handler just sets
+   sample_pending; the main interpreter loop notices that before the
+   next opcode and calls sample_take(), which walks the VM call stack
+   and counts one sample against it.
+
+   Glulx call frames don't record which function they belong to, so
+   while the sampler is running, enter_function() notes the address of
+   each function it enters, keyed by frame pointer. Frames which were
+   already on the stack when sampling began are shown by their PC
+   instead, as "pc=$XXXX". If the debugger is compiled in and game
+   debug info is loaded, every frame is resolved to its routine name.
+
+   Sampling is switched on at startup by the "--sample" option, and
+   switched on and off at any time by sending the interpreter process
+   SAMPLE_TOGGLE_SIGNAL ("kill -USR2 pid", or "kill -INFO pid" on the
+   Mac). Each time it is switched off, and when the VM exits normally,
+   the samples collected so far are written out in the "collapsed stack"
+   format used by flame-graph tools:
+
+   Main__;$3C;pc=$1A2B 12
+
+   (one line per distinct stack, outermost function first, followed by
+   the number of samples.) If the VM exits via glk_exit(), samples taken
+   since sampling was last switched off are lost.
+
+   The output file is created afresh once per run, replacing any earlier
+   one, and each batch of samples in that run is appended to it. With
+   "--sample FILE", FILE is created when the interpreter starts, as with
+   "--profile", even if no samples are ever written. Otherwise the
+   default "profile-samples" data file is only created the first time
+   samples are written.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Gargoyle's Mac front end uses SIGUSR1 and SIGUSR2 itself. */
+#ifdef __APPLE__
+#define SAMPLE_TOGGLE_SIGNAL (SIGINFO)
+#else
+#define SAMPLE_TOGGLE_SIGNAL (SIGUSR2)
+#endif
+
+#define SAMPLE_INTERVAL_USEC (1000)
+#define SAMPLE_MAX_DEPTH (256)
+#define SAMPLE_HASH_SIZE (1021)
+
+typedef struct sampleframe_struct {
+  glui32 addr; /* the function address, or the PC if the function is 
+                  unknown */
+  int known;
+} sampleframe_t;
+
+typedef struct stacksample_struct {
+  glui32 hash;
+  glui32 count;
+  int depth;
+  sampleframe_t *frames; /* innermost first */
+
+  struct stacksample_struct *hash_next;
+} stacksample_t;
+
+typedef struct callframe_struct {
+  glui32 frameptr;
+  glui32 addr;
+} callframe_t;
+
+/* These are globally visible, because the sample_tick() and 
+   sample_call() macros check them. */
+volatile sig_atomic_t sample_pending = FALSE;
+int sample_running = FALSE;
+
+static volatile sig_atomic_t sample_toggle = FALSE;
+static char *sample_filename = NULL;
+static strid_t sample_stream = NULL;
+static int sample_at_startup = FALSE;
+
+static stacksample_t **samples = NULL;
+static sampleframe_t sampleframes[SAMPLE_MAX_DEPTH];
+
+/* The functions entered since sampling began, in order of frameptr. */
+static callframe_t *callframes = NULL;
+static int numcallframes = 0;
+static int callframes_size = 0;
+
+static void sample_signal(int sig);
+static void sample_start(void);
+static void sample_stop(void);
+static void sample_write(void);
+
+/* This is called from the setup code, like setup_profile(). Pass a
+   writable stream, or a filename to be opened according to the usual
+   Glk data file rules; sampling will begin as soon as the VM starts.
+   If this is not called, the sampler is still ready to be switched on
+   by SAMPLE_TOGGLE_SIGNAL, and it will write to "profile-samples".
+   A filename (or the default) is opened, replacing any existing file,
+   the first time samples are written.
+*/
+void setup_sample(strid_t stream, char *filename)
+{
+  sample_at_startup = TRUE;
+
+  if (stream)
+    sample_stream = stream;
+  else if (filename)
+    sample_filename = filename;
+}
+
+int init_sample()
+{
+  struct sigaction act;
+  int bucknum;
+
+  samples = (stacksample_t **)glulx_malloc(SAMPLE_HASH_SIZE
+    * sizeof(stacksample_t *));
+  if (!samples)
+    return FALSE;
+
+  for (bucknum=0; bucknum<SAMPLE_HASH_SIZE; bucknum++) 
+    samples[bucknum] = NULL;
+
+  if (!sample_stream && !sample_filename)
+    sample_filename = "profile-samples";
+
+  memset(&act, 0, sizeof(act));
+  act.sa_handler = sample_signal;
+  sigemptyset(&act.sa_mask);
+  act.sa_flags = SA_RESTART;
+  sigaction(SIGPROF, &act, NULL);
+  sigaction(SAMPLE_TOGGLE_SIGNAL, &act, NULL);
+
+  if (sample_at_startup)
+    sample_start();
+
+  return TRUE;
+}
+
+static void sample_signal(int sig)
+{
+  if (sig == SAMPLE_TOGGLE_SIGNAL)
+    sample_toggle = TRUE;
+  sample_pending = TRUE;
+}
+
+static void set_sample_timer(int on)
+{
+  struct itimerval timer;
+
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = (on ? SAMPLE_INTERVAL_USEC : 0);
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+static void sample_start()
+{
+  if (sample_running)
+    return;
+
+  numcallframes = 0;
+  sample_running = TRUE;
+  set_sample_timer(TRUE);
+}
+
+static void sample_stop()
+{
+  if (!sample_running)
+    return;
+
+  set_sample_timer(FALSE);
+  sample_running = FALSE;
+  numcallframes = 0;
+  sample_write();
+}
+
+/* sample_note_call():
+   Called by enter_function() while the sampler is running, once the
+   new frame is in place. */
+void sample_note_call(glui32 addr)
+{
+  /* Discard any frames which have returned since. */
+  while (numcallframes && callframes[numcallframes-1].frameptr >= frameptr)
+    numcallframes--;
+
+  if (numcallframes >= callframes_size) {
+    int newsize = (callframes_size ? 2*callframes_size : 64);
+    callframe_t *newframes = (callframe_t *)glulx_realloc(callframes,
+      newsize * sizeof(callframe_t));
+    if (!newframes)
+      fatal_error("Sampler: cannot malloc call frames.");
+    callframes = newframes;
+    callframes_size = newsize;
+  }
+
+  callframes[numcallframes].frameptr = frameptr;
+  callframes[numcallframes].addr = addr;
+  numcallframes++;
+}
+
+/* sample_forget_calls():
+   Called when the stack has been replaced wholesale (restart, restore,
+   restoreundo). */
+void sample_forget_calls()
+{
+  numcallframes = 0;
+}
+
+/* sample_take():
+   Called by the main interpreter loop when a signal has arrived. */
+void sample_take()
+{
+  glui32 curpc, curframeptr, curstackptr;
+  glui32 hash;
+  int depth, ix, calls;
+  stacksample_t *sam;
+
+  sample_pending = FALSE;
+
+  if (sample_toggle) {
+    sample_toggle = FALSE;
+    if (sample_running)
+      sample_stop();
+    else
+      sample_start();
+    return;
+  }
+
+  if (!sample_running || !stack)
+    return;
+
+  /* Walk the frame chain, innermost first. The frame pointers get 
+     smaller as we go, and so do the ones in callframes. */
+  curpc = pc;
+  curframeptr = frameptr;
+  calls = numcallframes;
+  depth = 0;
+  while (depth < SAMPLE_MAX_DEPTH) {
+    sampleframe_t *fra = &sampleframes[depth];
+
+    while (calls && callframes[calls-1].frameptr > curframeptr)
+      calls--;
+    if (calls && callframes[calls-1].frameptr == curframeptr) {
+      fra->addr = callframes[calls-1].addr;
+      fra->known = TRUE;
+    }
+    else {
+      fra->addr = curpc;
+      fra->known = FALSE;
+#if VM_DEBUGGER
+      if (debugger_routine_for_address(curpc, &fra->addr))
+        fra->known = TRUE;
+#endif /* VM_DEBUGGER */
+    }
+    depth++;
+
+    curstackptr = curframeptr;
+    if (curstackptr < 16)
+      break;
+    curstackptr -= 16;
+    curpc = Stk4(curstackptr+8);
+    curframeptr = Stk4(curstackptr+12);
+  }
+
+  hash = depth;
+  for (ix=0; ix<depth; ix++)
+    hash = (hash * 31) + sampleframes[ix].addr + sampleframes[ix].known;
+
+  for (sam = samples[hash % SAMPLE_HASH_SIZE]; sam; sam = sam->hash_next) {
+    if (sam->hash == hash && sam->depth == depth
+      && !memcmp(sam->frames, sampleframes, depth * sizeof(sampleframe_t)))
+      break;
+  }
+
+  if (!sam) {
+    sam = (stacksample_t *)glulx_malloc(sizeof(stacksample_t));
+    if (!sam)
+      fatal_error("Sampler: cannot malloc sample.");
+    sam->frames = (sampleframe_t *)glulx_malloc(depth 
+      * sizeof(sampleframe_t));
+    if (!sam->frames)
+      fatal_error("Sampler: cannot malloc sample.");
+    memcpy(sam->frames, sampleframes, depth * sizeof(sampleframe_t));
+    sam->hash = hash;
+    sam->depth = depth;
+    sam->count = 0;
+    sam->hash_next = samples[hash % SAMPLE_HASH_SIZE];
+    samples[hash % SAMPLE_HASH_SIZE] = sam;
+  }
+
+  sam->count += 1;
+}
+
+/* sample_write():
+   Append the collected samples to the output file, and discard them. */
+static void sample_write()
+{
+  int bucknum, ix;
+  stacksample_t *sam, *next;
+  char linebuf[32];
+
+  if (!sample_stream) {
+    frefid_t sampref = glk_fileref_create_by_name(fileusage_TextMode|fileusage_Data, sample_filename, 0);
+    if (!sampref)
+      fatal_error_2("Sampler: unable to create sample output fileref", sample_filename);
+
+    sample_stream = glk_stream_open_file(sampref, filemode_Write, 0);
+    glk_fileref_destroy(sampref);
+    if (!sample_stream)
+      fatal_error_2("Sampler: unable to open sample output file", sample_filename);
+  }
+
+  for (bucknum=0; bucknum<SAMPLE_HASH_SIZE; bucknum++) {
+    for (sam = samples[bucknum]; sam; sam = next) {
+      next = sam->hash_next;
+
+      for (ix=sam->depth-1; ix>=0; ix--) {
+        sampleframe_t *fra = &sam->frames[ix];
+#if VM_DEBUGGER
+        const char *name = (fra->known ? debugger_routine_for_address(fra->addr, NULL) : NULL);
+        if (name) {
+          /* glk_put_string_stream() doesn't take a const string. */
+          for (; *name; name++)
+            glk_put_char_stream(sample_stream, *name);
+        }
+        else
+#endif /* VM_DEBUGGER */
+        {
+          sprintf(linebuf, (fra->known ? "$%lX" : "pc=$%lX"), 
+            (unsigned long)fra->addr);
+          glk_put_string_stream(sample_stream, linebuf);
+        }
+        if (ix)
+          glk_put_char_stream(sample_stream, ';');
+      }
+      sprintf(linebuf, " %ld\n", (long)sam->count);
+      glk_put_string_stream(sample_stream, linebuf);
+
+      glulx_free(sam->frames);
+      glulx_free(sam);
+    }
+    samples[bucknum] = NULL;
+  }
+}
+
+void sample_quit()
+{
+  sample_stop();
+
+  if (sample_stream) {
+    glk_stream_close(sample_stream, NULL);
+    sample_stream = NULL;
+  }
+}
+
+#endif /* VM_SAMPLING */
@@ -3,6 +3,7 @@
     http://eblong.com/zarf/glulx/index.html
 */
 
+#include <string.h>
 #include "glk.h"
 #include "glulxe.h"
 
@@ -39,6 +40,19 @@
 
 static void fetchkey(unsigned char *keybuf, glui32 key, glui32 keysize, 
   glui32 options);
+static glui32 structs_in_memory(glui32 start, glui32 structsize,
+  glui32 numstructs, glui32 keyoffset, glui32 keysize);
+static glui32 scan_structs(unsigned char *keybuf, glui32 key, glui32 keysize,
+  glui32 start, glui32 structsize, glui32 numstructs, glui32 keyoffset,
+  int zeroterm, int *matched);
+
+/* The fast paths below read keys straight out of memmap, without going
+   through Mem1() for every byte. They are only taken when the keys they
+   touch are known to lie within memory, so out-of-range searches still
+   reach the byte-at-a-time code (and its error checks) exactly as
+   before. Keys of one, two, or four bytes are compared as integers;
+   longer (indirect) keys are compared with memcmp(), which the C
+   library vectorizes. */
 
 /* linear_search():
    An array of data structures is stored in memory, beginning at start,
@@ -67,7 +81,32 @@ glui32 linear_search(glui32 key, glui32 keysize,
 
   fetchkey(keybuf, key, keysize, options);
 
-  for (count=0; count<numstructs; count++, start+=structsize) {
+  count = 0;
+  if (keysize != 0 
+    && (keysize <= 4 || structs_in_memory(key, 0, 1, 0, keysize))) {
+    glui32 avail = structs_in_memory(start, structsize, numstructs,
+      keyoffset, keysize);
+    if (avail) {
+      int matched;
+      count = scan_structs(keybuf, key, keysize, start, structsize, avail,
+        keyoffset, zeroterm, &matched);
+      if (count < avail) {
+        if (!matched) {
+          if (retindex)
+            return -1;
+          else
+            return 0;
+        }
+        if (retindex)
+          return count;
+        else
+          return start + count * structsize;
+      }
+      start += avail * structsize;
+    }
+  }
+
+  for (; count<numstructs; count++, start+=structsize) {
     int match = TRUE;
     if (keysize <= 4) {
       for (ix=0; match && ix<keysize; ix++) {
@@ -127,6 +166,48 @@ glui32 binary_search(glui32 key, glui32 keysize,
   int retindex = ((options & serop_ReturnIndex) != 0);
 
   fetchkey(keybuf, key, keysize, options);
+
+  if ((keysize == 1 || keysize == 2 || keysize == 4) && numstructs != 0
+    && structs_in_memory(start, structsize, numstructs, keyoffset,
+      keysize) == numstructs) {
+    /* Every key is in memory, so compare whole integers. The probe
+       sequence is the same as below, so the result is identical even
+       for arrays which break the no-duplicates rule. */
+    glui32 keyval, mval;
+    int less;
+    keyval = (keysize == 4) ? Read4(keybuf) 
+      : (keysize == 2) ? Read2(keybuf) : Read1(keybuf);
+    bot = 0;
+    top = numstructs;
+    while (bot < top) {
+      val = (top+bot) / 2;
+      addr = start + val * structsize;
+      switch (keysize) {
+      case 4:
+        mval = Read4(memmap + (glui32)(addr + keyoffset));
+        break;
+      case 2:
+        mval = Read2(memmap + (glui32)(addr + keyoffset));
+        break;
+      default:
+        mval = Read1(memmap + (glui32)(addr + keyoffset));
+        break;
+      }
+      if (mval == keyval) {
+        if (retindex)
+          return val;
+        else
+          return addr;
+      }
+      less = (mval < keyval);
+      bot = less ? val+1 : bot;
+      top = less ? top : val;
+    }
+    if (retindex)
+      return -1;
+    else
+      return 0;
+  }
   
   bot = 0;
   top = numstructs;
@@ -189,14 +270,39 @@ glui32 linked_search(glui32 key, glui32 keysize,
   glui32 start, glui32 keyoffset, glui32 nextoffset, glui32 options)
 {
   unsigned char keybuf[4];
+  unsigned char *keyptr;
   int ix;
+  glui32 jx;
   glui32 val;
   int zeroterm = ((options & serop_ZeroKeyTerminates) != 0);
 
   fetchkey(keybuf, key, keysize, options);
 
+  /* keyptr is set if the nodes' keys can be compared with memcmp(). */
+  keyptr = NULL;
+  if (keysize != 0 && keysize <= 4)
+    keyptr = keybuf;
+  else if (keysize > 4 && structs_in_memory(key, 0, 1, 0, keysize))
+    keyptr = memmap + key;
+
   while (start != 0) {
     int match = TRUE;
+    if (keyptr && structs_in_memory(start, 0, 1, keyoffset, keysize)) {
+      unsigned char *ptr = memmap + (glui32)(start + keyoffset);
+      if (memcmp(ptr, keyptr, keysize) == 0)
+        return start;
+      if (zeroterm) {
+        for (jx=0; jx<keysize; jx++) {
+          if (ptr[jx] != 0)
+            break;
+        }
+        if (jx == keysize)
+          break;
+      }
+      val = start + nextoffset;
+      start = Mem4(val);
+      continue;
+    }
     if (keysize <= 4) {
       for (ix=0; match && ix<keysize; ix++) {
         if (Mem1(start + keyoffset + ix) != keybuf[ix])
@@ -264,3 +370,109 @@ static void fetchkey(unsigned char *keybuf, glui32 key, glui32 keysize,
     }
   }
 }
+
+/* structs_in_memory():
+   Count how many of the numstructs structs beginning at start (at most)
+   have their entire key within the current memory map. Addresses wrap
+   around at 32 bits, just as they do for Mem1().
+*/
+static glui32 structs_in_memory(glui32 start, glui32 structsize,
+  glui32 numstructs, glui32 keyoffset, glui32 keysize)
+{
+  glui32 addr = start + keyoffset;
+  glui32 avail;
+
+  if (addr >= endmem || endmem - addr < keysize)
+    return 0;
+  if (structsize == 0)
+    return numstructs;
+  avail = (endmem - addr - keysize) / structsize + 1;
+  return (avail < numstructs) ? avail : numstructs;
+}
+
+/* scan_structs():
+   The inner loop of linear_search(), for numstructs structs which are
+   all known to be in memory (see structs_in_memory()). Returns the index
+   of the first struct whose key matches, or (if zeroterm is set) whose
+   key is all zeroes; *matched says which it was. If neither is found,
+   returns numstructs.
+*/
+static glui32 scan_structs(unsigned char *keybuf, glui32 key, glui32 keysize,
+  glui32 start, glui32 structsize, glui32 numstructs, glui32 keyoffset,
+  int zeroterm, int *matched)
+{
+  unsigned char *ptr = memmap + (glui32)(start + keyoffset);
+  unsigned char *keyptr;
+  glui32 count, keyval, zeroval, val = 0;
+  glui32 ix;
+
+  *matched = FALSE;
+
+  if (keysize == 1 && structsize == 1) {
+    /* A packed byte array, which memchr() can scan a word (or vector)
+       at a time. */
+    unsigned char *found = memchr(ptr, keybuf[0], numstructs);
+    if (found)
+      numstructs = found - ptr;
+    if (zeroterm && keybuf[0] != 0) {
+      unsigned char *zero = memchr(ptr, 0, numstructs);
+      if (zero)
+        return zero - ptr;
+    }
+    *matched = (found != NULL);
+    return numstructs;
+  }
+
+  /* For integer keys, a zero key stops the scan only if zeroterm is
+     set; otherwise zeroval is just the key again. A match always takes
+     precedence over a zero key. */
+  switch (keysize) {
+  case 4:
+    keyval = Read4(keybuf);
+    zeroval = zeroterm ? 0 : keyval;
+    for (count=0; count<numstructs; count++, ptr+=structsize) {
+      val = Read4(ptr);
+      if (val == keyval || val == zeroval)
+        break;
+    }
+    *matched = (count < numstructs && val == keyval);
+    return count;
+  case 2:
+    keyval = Read2(keybuf);
+    zeroval = zeroterm ? 0 : keyval;
+    for (count=0; count<numstructs; count++, ptr+=structsize) {
+      val = Read2(ptr);
+      if (val == keyval || val == zeroval)
+        break;
+    }
+    *matched = (count < numstructs && val == keyval);
+    return count;
+  case 1:
+    keyval = Read1(keybuf);
+    zeroval = zeroterm ? 0 : keyval;
+    for (count=0; count<numstructs; count++, ptr+=structsize) {
+      val = Read1(ptr);
+      if (val == keyval || val == zeroval)
+        break;
+    }
+    *matched = (count < numstructs && val == keyval);
+    return count;
+  }
+
+  keyptr = (keysize <= 4) ? keybuf : memmap + key;
+  for (count=0; count<numstructs; count++, ptr+=structsize) {
+    if (memcmp(ptr, keyptr, keysize) == 0) {
+      *matched = TRUE;
+      return count;
+    }
+    if (zeroterm) {
+      for (ix=0; ix<keysize; ix++) {
+        if (ptr[ix] != 0)
+          break;
+      }
+      if (ix == keysize)
+        return count;
+    }
+  }
+  return numstructs;
+}
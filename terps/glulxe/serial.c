@@ -39,6 +39,8 @@ static unsigned char **undo_chain = NULL;
 /* This will contain a copy of RAM (ramstate to endmem) as it exists
    in the game file. */
 static unsigned char *ramcache = NULL;
+
+static const unsigned char *original_ram(void);
 #endif /* SERIALIZE_CACHE_RAM */
 
 static glui32 write_memstate(dest_t *dest);
@@ -73,6 +75,12 @@ int init_serial()
   }
 
 #ifdef SERIALIZE_CACHE_RAM
+#ifdef GARGLK
+  /* If the game is in a memory-mapped Blorb file, the original RAM 
+     can be read straight from there; there's no need for a copy. */
+  if (gamefile_mapping())
+    return TRUE;
+#endif /* GARGLK */
   {
     glui32 len = (endmem - ramstart);
     glui32 res;
@@ -89,6 +97,25 @@ int init_serial()
   return TRUE;
 }
 
+#ifdef SERIALIZE_CACHE_RAM
+/* original_ram():
+   Return a pointer to RAM (ramstart to endgamefile) as it exists in
+   the game file.
+*/
+static const unsigned char *original_ram()
+{
+#ifdef GARGLK
+  if (!ramcache) {
+    const unsigned char *mapped = gamefile_mapping();
+    if (!mapped)
+      fatal_error("The game file is no longer available.");
+    return mapped + ramstart;
+  }
+#endif /* GARGLK */
+  return ramcache;
+}
+#endif /* SERIALIZE_CACHE_RAM */
+
 /* final_serial():
    Clean up memory when the VM shuts down.
 */
@@ -695,6 +722,7 @@ static glui32 write_memstate(dest_t *dest)
   unsigned char ch;
 #ifdef SERIALIZE_CACHE_RAM
   glui32 cachepos;
+  const unsigned char *cache;
 #endif /* SERIALIZE_CACHE_RAM */
 
   res = write_long(dest, endmem);
@@ -705,6 +733,7 @@ static glui32 write_memstate(dest_t *dest)
 
 #ifdef SERIALIZE_CACHE_RAM
   cachepos = 0;
+  cache = original_ram();
 #else /* SERIALIZE_CACHE_RAM */
   glk_stream_set_position(gamefile, gamefile_start+ramstart, seekmode_Start);
 #endif /* SERIALIZE_CACHE_RAM */
@@ -713,7 +742,7 @@ static glui32 write_memstate(dest_t *dest)
     ch = Mem1(pos);
     if (pos < endgamefile) {
 #ifdef SERIALIZE_CACHE_RAM
-      val = ramcache[cachepos];
+      val = cache[cachepos];
       cachepos++;
 #else /* SERIALIZE_CACHE_RAM */
       val = glk_get_char_stream(gamefile);
@@ -762,6 +791,7 @@ static glui32 read_memstate(dest_t *dest, glui32 chunklen)
   unsigned char ch, ch2;
 #ifdef SERIALIZE_CACHE_RAM
   glui32 cachepos;
+  const unsigned char *cache;
 #endif /* SERIALIZE_CACHE_RAM */
 
   heap_clear();
@@ -778,6 +808,7 @@ static glui32 read_memstate(dest_t *dest, glui32 chunklen)
 
 #ifdef SERIALIZE_CACHE_RAM
   cachepos = 0;
+  cache = original_ram();
 #else /* SERIALIZE_CACHE_RAM */
   glk_stream_set_position(gamefile, gamefile_start+ramstart, seekmode_Start);
 #endif /* SERIALIZE_CACHE_RAM */
@@ -785,7 +816,7 @@ static glui32 read_memstate(dest_t *dest, glui32 chunklen)
   for (pos=ramstart; pos<endmem; pos++) {
     if (pos < endgamefile) {
 #ifdef SERIALIZE_CACHE_RAM
-      val = ramcache[cachepos];
+      val = cache[cachepos];
       cachepos++;
 #else /* SERIALIZE_CACHE_RAM */
       val = glk_get_char_stream(gamefile);
@@ -1101,6 +1132,7 @@ static glui32 read_stackstate(dest_t *dest, glui32 chunklen, int portable)
   frameptr = 0;
   valstackbase = 0;
   localsbase = 0;
+  sample_forget_calls();
 
   if (!portable) {
     res = read_buffer(dest, stack, stackptr);
@@ -49,6 +49,10 @@ glkunix_argumentlist_t glkunix_arguments[] = {
   { "--profcalls", glkunix_arg_NoValue, "Include what-called-what details in profiling. (Slow!)" },
 #endif /* VM_PROFILING */
 
+#if VM_SAMPLING
+  { "--sample", glkunix_arg_ValueFollows, "Write sampled call stacks (for flame graphs) to a file." },
+#endif /* VM_SAMPLING */
+
 #if VM_DEBUGGER
   { "--gameinfo", glkunix_arg_ValueFollows, "Read debug information from a file." },
   { "--cpu", glkunix_arg_NoValue, "Display CPU usage of each command (debug)." },
@@ -166,6 +170,22 @@ int glkunix_startup_code(glkunix_startup_t *data)
     }
 #endif /* VM_PROFILING */
 
+#if VM_SAMPLING
+    if (!strcmp(data->argv[ix], "--sample")) {
+      ix++;
+      if (ix<data->argc) {
+        strid_t samplestr = glkunix_stream_open_pathname_gen(data->argv[ix], TRUE, TRUE, 1);
+        if (!samplestr) {
+          init_err = "Unable to open sample output file.";
+          init_err2 = data->argv[ix];
+          return TRUE;
+        }
+        setup_sample(samplestr, NULL);
+      }
+      continue;
+    }
+#endif /* VM_SAMPLING */
+
 #if VM_DEBUGGER
     if (!strcmp(data->argv[ix], "--gameinfo")) {
       ix++;
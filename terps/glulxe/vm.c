@@ -156,6 +156,9 @@ void vm_restart()
   int res;
   int bufpos;
   char buf[0x100];
+#ifdef GARGLK
+  const unsigned char *mapped;
+#endif /* GARGLK */
 
   /* Deactivate the heap (if it was active). */
   heap_clear();
@@ -165,12 +168,25 @@ void vm_restart()
   if (lx)
     fatal_error("Memory could not be reset to its original size.");
 
+#ifdef GARGLK
+  /* If the game is in a memory-mapped Blorb file, copy main memory
+     straight from there. */
+  mapped = gamefile_mapping();
+#endif /* GARGLK */
+
   /* Load in all of main memory. We do this in 256-byte chunks, because
      why rely on OS stream buffering? */
   glk_stream_set_position(gamefile, gamefile_start, seekmode_Start);
   bufpos = 0x100;
 
   for (lx=0; lx<endgamefile; lx++) {
+#ifdef GARGLK
+    if (mapped) {
+      if (lx < protectstart || lx >= protectend)
+        memmap[lx] = mapped[lx];
+      continue;
+    }
+#endif /* GARGLK */
     if (bufpos >= 0x100) {
       int count = glk_get_buffer_stream(gamefile, buf, 0x100);
       if (count != 0x100) {
@@ -191,6 +207,7 @@ void vm_restart()
   /* Reset all the registers */
   stackptr = 0;
   frameptr = 0;
+  sample_forget_calls();
   pc = 0;
   prevpc = 0;
   stream_set_iosys(0, 0);
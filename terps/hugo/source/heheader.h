@@ -1027,6 +1027,7 @@ extern unsigned int speaktoaddr;
 extern unsigned int performaddr;
 extern int objects;
 extern int events;
+extern int properties;
 extern int dictcount;
 extern int syncount;
 #if !defined (COMPILE_V25)
@@ -1068,6 +1069,7 @@ extern char leftquote;
 /* heobject.c */
 int Child(int obj);
 int Children(int obj);
+void ClearPropCache(int obj);
 int Elder(int obj);
 unsigned long GetAttributes(int obj, int attribute_set);
 int GetProp(int obj, int p, int n, char s);
@@ -1091,6 +1093,7 @@ extern int display_pointer_x, display_pointer_y;
 int Available(int obj, char non_grammar);
 void CallLibraryParse(void);
 void FindObjProp(int obj);
+void ClearDictIndex(void);
 unsigned int FindWord(char *a);
 void KillWord(int a);
 int MatchCommand(void);
@@ -81,6 +81,7 @@ unsigned int performaddr;		/* "Perform"			*/
 /* Totals */
 int objects;
 int events;
+int properties;		/* property numbers */
 int dictcount;		/* dictionary entries */
 int syncount;		/* synonyms, etc.     */
 
@@ -1471,12 +1472,18 @@ void LoadGame(void)
 	defseg = eventtable;
 	events = PeekWord(0);
 
+	defseg = proptable;
+	properties = PeekWord(0);
+
 	defseg = dicttable;
 	dictcount = PeekWord(0);
+	ClearDictIndex();
 
 	defseg = syntable;
 	syncount = PeekWord(0);
 
+	ClearPropCache(-1);
+
 
 	/* Additional information to be found: */
 
@@ -2499,6 +2506,7 @@ int Undo()
 	int count = 0, n;
 	int turns, turncount, tempptr;
 	int obj, prop, attr, v;
+	int oldlen, newlen;
 	unsigned int addr;
 
 	if (--undoptr < 0) undoptr = MAXUNDO-1;
@@ -2558,6 +2566,7 @@ int Undo()
 					if ((addr = PropAddr(obj, prop, 0))!=0)
 					{
 						defseg = proptable;
+						oldlen = Peek(addr+1);
 
 						if (n==PROP_ROUTINE)
 						{
@@ -2571,6 +2580,14 @@ int Undo()
 						else if (Peek(addr+1)==PROP_ROUTINE || Peek(addr+1)<(unsigned char)n)
 							Poke(addr+1, (unsigned char)n);
 
+						/* As in RunSet(), a change
+						   of length moves any following
+						   properties
+						*/
+						newlen = Peek(addr+1);
+						if ((newlen==PROP_ROUTINE?1:newlen) != (oldlen==PROP_ROUTINE?1:oldlen))
+							ClearPropCache(obj);
+
 						/* property length */
 						if (n<=(int)Peek(addr+1))
 							PokeWord(addr+2+(n-1)*2, v);
@@ -2618,6 +2635,7 @@ int Undo()
 				{
 					defseg = dicttable;
 					PokeWord(0, --dictcount);
+					ClearDictIndex();
 					count++;
 					break;
 				}
@@ -3,8 +3,9 @@
 
 	Object/property/attribute management functions:
 
-		Child                   PutAttributes
-		Children                SetAttribute
+		Child                   PropAddr
+		Children                PutAttributes
+		ClearPropCache          SetAttribute
 		Elder                   Sibling
 		GetAttributes           TestAttribute
 		GetProp                 Youngest
@@ -12,7 +13,6 @@
 		MoveObj
 		Name
 		Parent
-		PropAddr
 
 	for the Hugo Engine
 
@@ -30,6 +30,20 @@ int display_object = -1;		/* i.e., non-existent (yet) */
 char display_needs_repaint = 0;		/* for display object       */
 int display_pointer_x = 0, display_pointer_y = 0;
 
+static unsigned int *CacheProps(int obj);
+
+/* Property address cache:  for each object whose properties have been
+   looked up, the address of its first entry for each property number
+   (or 0 if it has none), found with a single walk of its property
+   table.  Property values change all the time, but the layout of the
+   table only changes when it is reloaded (restart, restore) or when an
+   assignment or undo changes a property's length, and ClearPropCache()
+   is called in those cases.
+*/
+static unsigned int **propcache = NULL;
+static int propcache_objects = 0;	/* objects allocated for	*/
+static int propcache_props = 0;		/* property numbers per object	*/
+
 
 /* CHECKOBJECTRANGE
 
@@ -593,6 +607,94 @@ int Parent(int obj)
 }
 
 
+/* CACHEPROPS
+
+	Walks the property table of <obj> once to fill in its entries in
+	the property address cache, returning them (or NULL if there
+	isn't enough memory).
+*/
+
+static unsigned int *CacheProps(int obj)
+{
+	unsigned char seen[256];
+	unsigned char c;
+	unsigned int *cache;
+	unsigned int ptr;
+	int i, proplen;
+
+	if (!propcache)
+	{
+		propcache_objects = objects;
+		propcache_props = properties;
+		propcache = (unsigned int **)hugo_blockalloc(sizeof(unsigned int *)*propcache_objects);
+		if (!propcache) return NULL;
+		for (i=0; i<propcache_objects; i++)
+			propcache[i] = NULL;
+	}
+
+	if (obj >= propcache_objects) return NULL;
+
+	cache = (unsigned int *)hugo_blockalloc(sizeof(unsigned int)*(propcache_props + 1));
+	if (!cache) return NULL;
+	for (i=0; i<=propcache_props; i++)
+		cache[i] = 0;
+	memset(seen, 0, sizeof(seen));
+
+	defseg = objtable;
+	ptr = PeekWord(object_size*(obj+1));
+	defseg = proptable;
+
+	while ((c = Peek(ptr)) != PROP_END)
+	{
+		if (c <= propcache_props && !seen[c])
+		{
+			cache[c] = ptr;
+			seen[c] = 1;
+		}
+
+		proplen = Peek(ptr + 1);
+		if (proplen==PROP_ROUTINE) proplen = 1;
+		ptr += proplen * 2 + 2;
+	}
+
+	defseg = gameseg;
+
+	return propcache[obj] = cache;
+}
+
+
+/* CLEARPROPCACHE
+
+	Discards the cached property addresses for <obj>, or for every
+	object if <obj> is -1.
+*/
+
+void ClearPropCache(int obj)
+{
+	int i;
+
+	if (!propcache) return;
+
+	if (obj >= 0)
+	{
+		if (obj < propcache_objects && propcache[obj])
+		{
+			hugo_blockfree(propcache[obj]);
+			propcache[obj] = NULL;
+		}
+		return;
+	}
+
+	for (i=0; i<propcache_objects; i++)
+	{
+		if (propcache[i]) hugo_blockfree(propcache[i]);
+	}
+	hugo_blockfree(propcache);
+	propcache = NULL;
+	propcache_objects = propcache_props = 0;
+}
+
+
 /* PROPADDR
 
 	Returns address of <obj>.<p> (with <offset> provided for additive
@@ -615,6 +717,25 @@ unsigned int PropAddr(int obj, int p, unsigned int offset)
 	*/
 	if (obj<0 || obj>=objects) return 0;
 
+	/* Only the low byte of the property number matters in the
+	   table walk below, so that's what the cache is indexed by
+	*/
+	if (!offset)
+	{
+		unsigned int *cache = NULL;
+
+		if (propcache && obj < propcache_objects)
+			cache = propcache[obj];
+		if (!cache)
+			cache = CacheProps(obj);
+
+		if (cache && (unsigned char)p <= propcache_props)
+		{
+			defseg = gameseg;
+			return cache[(unsigned char)p];
+		}
+	}
+
 	defseg = objtable;
 
 	/* Position in the property table...
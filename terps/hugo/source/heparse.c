@@ -5,6 +5,7 @@
 
 		Available
 		CallLibraryParse
+		ClearDictIndex
 		FindWord
 		KillWord
 		Match routines
@@ -53,6 +54,9 @@ void TryObj(int obj);
 
 int GetVal(void);			/* from heexpr.c */
 
+static int BuildDictIndex(void);
+static unsigned int HashDictWord(char *a, int len);
+
 #define MAXOBJLIST 32
 
 #define STARTS_AS_NUMBER(a) (((a[0]>='0' && a[0]<='9') || a[0]=='-')?1:0)
@@ -417,6 +421,141 @@ int DomainObj(int obj)
 }
 
 
+/* Dictionary index:  FindWord() is called for every input word (and
+   more), so rather than scanning the dictionary table, it looks words
+   up in two chained hash tables over the dictionary entries.  The first
+   is keyed by the whole word, the second by the first DICT_PREFIX_LEN
+   characters of each word that long or longer, for the "first six
+   characters" fallback.  The index is built the first time it's needed
+   and extended as Dict() adds new entries; ClearDictIndex() must be
+   called whenever the dictionary table is otherwise changed.
+*/
+
+#define DICT_PREFIX_LEN 6
+
+static int dict_indexed = 0;		/* entries indexed so far	*/
+static int dict_indexsize = 0;		/* entries allocated		*/
+static unsigned int dict_hashsize = 0;	/* buckets (a power of 2)	*/
+static unsigned int dict_nextptr;	/* address of next entry	*/
+static unsigned int *dict_addr = NULL;	/* entry addresses		*/
+static int *dict_head = NULL, *dict_next = NULL;
+static int *dict_prefixhead = NULL, *dict_prefixnext = NULL;
+
+/* CLEARDICTINDEX
+
+	Throws away the dictionary index; it will be rebuilt on the
+	next call to FindWord().
+*/
+
+void ClearDictIndex(void)
+{
+	if (dict_addr) hugo_blockfree(dict_addr);
+	if (dict_head) hugo_blockfree(dict_head);
+	if (dict_next) hugo_blockfree(dict_next);
+	if (dict_prefixhead) hugo_blockfree(dict_prefixhead);
+	if (dict_prefixnext) hugo_blockfree(dict_prefixnext);
+
+	dict_addr = NULL;
+	dict_head = dict_next = NULL;
+	dict_prefixhead = dict_prefixnext = NULL;
+	dict_indexed = dict_indexsize = 0;
+	dict_hashsize = 0;
+}
+
+
+/* HASHDICTWORD
+
+	Hashes the first <len> characters of <a>.
+*/
+
+static unsigned int HashDictWord(char *a, int len)
+{
+	unsigned int h = 2166136261U;
+	int i;
+
+	for (i=0; i<len; i++)
+	{
+		h ^= (unsigned char)a[i];
+		h *= 16777619U;
+	}
+
+	return h;
+}
+
+
+/* BUILDDICTINDEX
+
+	Brings the dictionary index up to date with dictcount, returning
+	false if there isn't enough memory (in which case FindWord()
+	falls back to scanning the table).  Expects defseg to be
+	dicttable.
+*/
+
+static int BuildDictIndex(void)
+{
+	char *entry;
+	unsigned int h;
+	int i, p;
+
+	if (dictcount < dict_indexed)
+		ClearDictIndex();
+
+	/* (Re)allocate if the new entries won't fit in the current tables,
+	   leaving room for Dict() to add more
+	*/
+	if (dictcount > dict_indexsize || !dict_head)
+	{
+		int newsize = dictcount + dictcount/4 + 16;
+
+		ClearDictIndex();
+
+		for (dict_hashsize=64; dict_hashsize<(unsigned int)newsize; dict_hashsize*=2);
+
+		dict_addr = (unsigned int *)hugo_blockalloc(sizeof(unsigned int)*newsize);
+		dict_next = (int *)hugo_blockalloc(sizeof(int)*newsize);
+		dict_prefixnext = (int *)hugo_blockalloc(sizeof(int)*newsize);
+		dict_head = (int *)hugo_blockalloc(sizeof(int)*dict_hashsize);
+		dict_prefixhead = (int *)hugo_blockalloc(sizeof(int)*dict_hashsize);
+
+		if (!dict_addr || !dict_next || !dict_prefixnext || !dict_head || !dict_prefixhead)
+		{
+			ClearDictIndex();
+			return false;
+		}
+
+		for (h=0; h<dict_hashsize; h++)
+			dict_head[h] = dict_prefixhead[h] = -1;
+		dict_indexsize = newsize;
+		dict_nextptr = 0;
+	}
+
+	for (i=dict_indexed; i<dictcount; i++)
+	{
+		p = Peek(dict_nextptr+2);
+		entry = GetString(dict_nextptr+2);
+
+		dict_addr[i] = dict_nextptr;
+
+		h = HashDictWord(entry, p) & (dict_hashsize-1);
+		dict_next[i] = dict_head[h];
+		dict_head[h] = i;
+
+		dict_prefixnext[i] = -1;
+		if (p >= DICT_PREFIX_LEN)
+		{
+			h = HashDictWord(entry, DICT_PREFIX_LEN) & (dict_hashsize-1);
+			dict_prefixnext[i] = dict_prefixhead[h];
+			dict_prefixhead[h] = i;
+		}
+
+		dict_nextptr += p + 1;
+	}
+	dict_indexed = dictcount;
+
+	return true;
+}
+
+
 /* FINDWORD
 
 	Returns the dictionary address of <a>.
@@ -434,6 +573,65 @@ unsigned int FindWord(char *a)
 
 	defseg = dicttable;
 
+	if (BuildDictIndex())
+	{
+		unsigned int found = UNKNOWN_WORD;
+		int foundentry = dictcount;
+
+		/* Chains run from the most recently added entry, so keep
+		   going to find the first match in dictionary order, as
+		   the table scan below would
+		*/
+		i = dict_head[HashDictWord(a, alen) & (dict_hashsize-1)];
+		for (; i>=0; i=dict_next[i])
+		{
+			ptr = dict_addr[i];
+			if (alen==Peek(ptr+2) && (unsigned char)(MEM(dicttable*16L+ptr+3)-CHAR_TRANSLATION)==(unsigned char)a[0])
+			{
+				if (!strcmp(GetString(ptr + 2), a) && i < foundentry)
+				{
+					found = ptr;
+					foundentry = i;
+				}
+			}
+		}
+		if (found!=UNKNOWN_WORD)
+		{
+			defseg = gameseg;
+			return found;
+		}
+
+		if (alen >= DICT_PREFIX_LEN)
+		{
+			unsigned int possible = 0;
+			int posscount = 0;
+
+			i = dict_prefixhead[HashDictWord(a, DICT_PREFIX_LEN) & (dict_hashsize-1)];
+			for (; i>=0; i=dict_prefixnext[i])
+			{
+				ptr = dict_addr[i];
+				if (alen<=Peek(ptr+2) && (unsigned char)MEM(dicttable*16L+ptr+3)-CHAR_TRANSLATION==a[0])
+				{
+					if (!strncmp(GetString(ptr + 2), a, alen))
+					{
+						if (!strrchr(GetString(ptr+2), ' '))
+						{
+							possible = ptr;
+							posscount++;
+						}
+					}
+				}
+			}
+
+			if (posscount==1)
+				return possible;
+		}
+
+		defseg = gameseg;
+
+		return UNKNOWN_WORD;
+	}
+
 	for (i=1; i<=dictcount; i++)
 	{
 		if (alen==(p = Peek(ptr+2)) && (unsigned char)(MEM(dicttable*16L+ptr+3)-CHAR_TRANSLATION)==(unsigned char)a[0])
@@ -451,7 +649,7 @@ unsigned int FindWord(char *a)
 	/* As a last resort, see if the first 6 characters of the word (if it
 	   has at least six characters) match a dictionary word:
 	*/
-	if (alen >= 6)
+	if (alen >= DICT_PREFIX_LEN)
 	{
 		unsigned int possible = 0;
 		int posscount = 0;
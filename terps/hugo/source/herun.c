@@ -1125,6 +1125,10 @@ int RunRestart()
 	long i = 0;
 	HUGO_FILE file;
 
+	/* The dictionary and property tables are about to be reloaded */
+	ClearDictIndex();
+	ClearPropCache(-1);
+
 #ifndef LOADGAMEDATA_REPLACED
 
 	remaining = 0;
@@ -1265,6 +1269,9 @@ int RestoreGameData(void)
 
 	/* Restore objtable and above */
 
+	ClearDictIndex();
+	ClearPropCache(-1);
+
 	if (fseek(game, objtable*16L, SEEK_SET)) goto RestoreError;
 	i = 0;
 
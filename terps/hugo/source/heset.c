@@ -454,7 +454,13 @@ GetNextPropVal:
 				{
 					SaveUndo(PROP_T, obj, (unsigned int)set_value, n, PeekWord((unsigned int)(m+2+(n-1)*2)));
 
-					/* Save the (possibly changed) length) */
+					/* Save the (possibly changed) length), which
+					   moves any following properties if it
+					   turns a routine into more than one word
+					   or vice versa
+					*/
+					if ((newl==PROP_ROUTINE?1:newl) != (Peek(m+1)==PROP_ROUTINE?1:Peek(m+1)))
+						ClearPropCache(obj);
 					Poke((unsigned int)m + 1, (unsigned char)newl);
 
 					/* An assignment such as obj.prop++ or
@@ -5,6 +5,7 @@
 
 #define MAX_WORDS               20
 #define STACK_SIZE              20
+#define SYMBOL_BUCKETS          1024
 #define MAX_UNDO                100
 #define MAX_OBJECTS             1000
 
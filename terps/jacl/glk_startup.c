@@ -114,6 +114,20 @@ int glkunix_startup_code(glkunix_startup_t *data)
 		return (TRUE);
 	}
 
+	/* READ THE WHOLE PROCESSED FILE INTO MEMORY. ALL FURTHER ACCESS TO THE
+	 * GAME'S CODE IS MADE THROUGH program_seek() AND program_get_line() */
+	if (!load_program(game_stream)) {
+		strcpy (error_buffer, NOT_FOUND);
+		jpp_error = TRUE;
+	}
+
+	glk_stream_close(game_stream, NULL);
+	game_stream = NULL;
+
+	if (jpp_error) {
+		return (TRUE);
+	}
+
 	/* SET THE LIBRARY'S IDEA OF THE "CURRENT DIRECTORY" FOR THE EXECUTING
 	 * PROGRAM. THE ARGUMENT SHOULD BE THE NAME OF A FILE (NOT A DIRECTORY).
 	 * WHEN THIS IS SET, fileref_create_by_name() WILL CREATE FILES IN THE SAME
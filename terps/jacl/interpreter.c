@@ -217,6 +217,8 @@ extern struct string_type		*string_table;
 extern struct string_type		*cstring_table;
 extern struct function_type		*function_table;
 extern struct function_type		*executing_function;
+extern struct symbol_index		cinteger_index;
+extern struct symbol_index		cstring_index;
 extern struct command_type		*completion_list;
 extern struct word_type			*grammar_table;
 extern struct synonym_type		*synonym_table;
@@ -279,6 +281,8 @@ terminate(code)
 	if (game_stream != NULL) {
     	glk_stream_close(game_stream, NULL);
 	}
+
+	free_program();
 	
     glk_exit();
 #else
@@ -385,7 +389,7 @@ execute(funcname)
 	}
 
 #ifdef GLK
-	push_stack(glk_stream_get_position(game_stream));
+	push_stack(program_tell());
 #else
     push_stack(ftell(file));
 #endif
@@ -413,9 +417,9 @@ execute(funcname)
 
 	// JUMP TO THE POINT IN THE PROCESSED GAME FILE WHERE THIS FUNCTION STARTS 
 #ifdef GLK
-	glk_stream_set_position(game_stream, executing_function->position, seekmode_Start);
+	program_seek(executing_function->position);
     before_command = executing_function->position;
-	result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+	result = program_get_line(text_buffer, (glui32) 1024);
 #else
     fseek(file, executing_function->position, SEEK_SET);
     before_command = executing_function->position;
@@ -437,7 +441,7 @@ execute(funcname)
 					log_error(error_buffer, PLUS_STDOUT);
 				} else {
 #ifdef GLK
-					glk_stream_set_position(game_stream, top_of_while, seekmode_Start);
+					program_seek(top_of_while);
 #else
                     fseek(file, top_of_while, SEEK_SET);
 #endif
@@ -454,7 +458,7 @@ execute(funcname)
 					log_error(error_buffer, PLUS_STDOUT);
 				} else {
 #ifdef GLK
-					glk_stream_set_position(game_stream, top_of_iterate, seekmode_Start);
+					program_seek(top_of_iterate);
 #else
                     fseek(file, top_of_iterate, SEEK_SET);
 #endif
@@ -471,7 +475,7 @@ execute(funcname)
 					log_error(error_buffer, PLUS_STDOUT);
 				} else {
 #ifdef GLK
-					glk_stream_set_position(game_stream, top_of_update, seekmode_Start);
+					program_seek(top_of_update);
 #else
                     fseek(file, top_of_update, SEEK_SET);
 #endif
@@ -482,7 +486,7 @@ execute(funcname)
 			// SKIP THIS BLOCK OF PLAIN TEXT UNTIL IT FINDS A 
 			// LINE THAT STARTS WITH A '.' OR A '}'
 #ifdef GLK
-			glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+			program_get_line(text_buffer, (glui32) 1024);
 #else
 			fgets(text_buffer, 1024, file);
 #endif
@@ -497,7 +501,7 @@ execute(funcname)
 
 				// GET THE NEXT LINE
 #ifdef GLK
-				glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+				program_get_line(text_buffer, (glui32) 1024);
 #else
 				fgets(text_buffer, 1024, file);
 #endif
@@ -527,7 +531,7 @@ execute(funcname)
 				look_around();
 			} else if (!strcmp(word[0], "repeat")) {
 #ifdef GLK
-				top_of_do_loop = glk_stream_get_position(game_stream);
+				top_of_do_loop = program_tell();
 #else
                 top_of_do_loop = ftell(file);
 #endif
@@ -542,7 +546,7 @@ execute(funcname)
 						log_error(error_buffer, PLUS_STDOUT);
 					} else if (!condition()) {
 #ifdef GLK
-						glk_stream_set_position(game_stream, top_of_do_loop, seekmode_Start);
+						program_seek(top_of_do_loop);
 #else
                         fseek(file, top_of_do_loop, SEEK_SET);
 #endif
@@ -559,7 +563,7 @@ execute(funcname)
 						log_error(error_buffer, PLUS_STDOUT);
 					} else if (!and_condition()) {
 #ifdef GLK
-						glk_stream_set_position(game_stream, top_of_do_loop, seekmode_Start);
+						program_seek(top_of_do_loop);
 #else
 						fseek(file, top_of_do_loop, SEEK_SET);
 #endif
@@ -794,7 +798,7 @@ execute(funcname)
 				/* THE LOOP COMMAND LOOPS ONCE FOR EACH DEFINED 
 				 * OBJECT (FOREACH) */
 #ifdef GLK
-				top_of_loop = glk_stream_get_position(game_stream);
+				top_of_loop = program_tell();
 #else
                 top_of_loop = ftell(file);
 #endif
@@ -825,7 +829,7 @@ execute(funcname)
 						*loop_integer = 0;
 					} else {
 #ifdef GLK
-						glk_stream_set_position(game_stream, top_of_loop, seekmode_Start);
+						program_seek(top_of_loop);
 #else
                         fseek(file, top_of_loop, SEEK_SET);
 #endif
@@ -835,7 +839,7 @@ execute(funcname)
 				/* THE SELECT COMMAND LOOPS ONCE FOR EACH DEFINED 
 				 * OBJECT THAT MATCHES THE SUPPLIED CRITERION */
 #ifdef GLK
-				top_of_select = glk_stream_get_position(game_stream);
+				top_of_select = program_tell();
 #else
                 top_of_select = ftell(file);
 #endif
@@ -905,7 +909,7 @@ execute(funcname)
 				if (*select_integer == 0) {
 					// THERE ARE NO MATCHING OBJECTS SO JUMP TO THE endselect
 #ifdef GLK
-					glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+					program_get_line(text_buffer, (glui32) 1024);
 #else
 					fgets(text_buffer, 1024, file);
 #endif
@@ -918,7 +922,7 @@ execute(funcname)
 							break;
 						}
 #ifdef GLK
-						glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+						program_get_line(text_buffer, (glui32) 1024);
 #else
 						fgets(text_buffer, 1024, file);
 #endif
@@ -931,7 +935,7 @@ execute(funcname)
 				} else {
 					if (select_next(select_integer, criterion_type, criterion_value, scope_criterion)) {
 #ifdef GLK
-						glk_stream_set_position(game_stream, top_of_select, seekmode_Start);
+						program_seek(top_of_select);
 #else
                         fseek(file, top_of_select, SEEK_SET);
 #endif
@@ -1572,7 +1576,7 @@ execute(funcname)
 				 * ALL STATE MUST BE SAVED SO THE CURRENT MOVE CAN CONTINUE
 				 * ONCE THE PROXIED MOVE IS COMPLETE */
 #ifdef GLK
-				push_stack(glk_stream_get_position(game_stream));
+				push_stack(program_tell());
 #else
                 push_stack(ftell(file));
 #endif
@@ -1679,7 +1683,7 @@ execute(funcname)
 				// DISPLAYS A BLOCK OF PLAIN TEXT UNTIL IT FINDS A 
 				// LINE THAT STARTS WITH A '.' OR A '}'
 #ifdef GLK
-				glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+				program_get_line(text_buffer, (glui32) 1024);
 #else
                 fgets(text_buffer, 1024, file);
 #endif
@@ -1730,7 +1734,7 @@ execute(funcname)
 
 					// GET THE NEXT LINE
 #ifdef GLK
-					glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+					program_get_line(text_buffer, (glui32) 1024);
 #else
                     fgets(text_buffer, 1024, file);
 #endif
@@ -2348,8 +2352,8 @@ execute(funcname)
 		}
 
 #ifdef GLK
-		before_command = glk_stream_get_position(game_stream);
-		glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+		before_command = program_tell();
+		program_get_line(text_buffer, (glui32) 1024);
 #else
         before_command = ftell(file);
         fgets(text_buffer, 1024, file);
@@ -2724,7 +2728,7 @@ pop_stack()
 	select_integer = backup[stack].select_integer;
 
 #ifdef GLK
-	glk_stream_set_position(game_stream, backup[stack].address, seekmode_Start);
+	program_seek(backup[stack].address);
 #else
     fseek(file, backup[stack].address, SEEK_SET);
 #endif
@@ -3221,6 +3225,7 @@ add_cinteger(name, value)
 		}
 		strncpy(new_cinteger->name, name, 40);
 		new_cinteger->name[40] = 0;
+		index_symbol(&cinteger_index, new_cinteger->name, new_cinteger);
 		new_cinteger->value = value;
 		new_cinteger->next_cinteger = NULL;
 	}
@@ -3233,6 +3238,8 @@ clear_cinteger(name)
     /* FREE CONSTANTS THAT HAVE SUPPLIED NAME*/
 
 	//printf("--- clear integer %s\n", name);
+	unindex_symbol(&cinteger_index, name);
+
 	if (cinteger_table != NULL) {
 		current_cinteger = cinteger_table;
 		previous_cinteger = cinteger_table;
@@ -3286,6 +3293,7 @@ add_cstring(name, value)
 		}
 		strncpy(new_string->name, name, 40);
 		new_string->name[40] = 0;
+		index_symbol(&cstring_index, new_string->name, new_string);
 		strncpy(new_string->value, value, 255);
 		new_string->value[255] = 0;
 		new_string->next_string = NULL;
@@ -3297,6 +3305,8 @@ clear_cstring(name)
   char *name;
 {
     /* FREE CONSTANTS THAT HAVE SUPPLIED NAME*/
+	unindex_symbol(&cstring_index, name);
+
 	if (cstring_table != NULL) {
 		current_cstring = cstring_table;
 		previous_cstring = cstring_table;
@@ -116,6 +116,13 @@ int             objects, integers, functions, strings;
 /* A STREAM FOR THE GAME FILE, WHEN IT'S OPEN. */
 strid_t         game_stream = NULL;
 
+/* THE PROCESSED GAME FILE, READ INTO MEMORY ONCE AT STARTUP SO THAT
+ * EXECUTING CODE NEVER HAS TO GO BACK TO THE DISK. program_position IS
+ * THE OFFSET OF THE NEXT LINE TO BE READ, JUST LIKE A FILE POSITION */
+static char		*program_text = NULL;
+static glsi32	program_length = 0;
+static glsi32	program_position = 0;
+
 /* THE STREAM FOR OPENING UP THE ARCHIVE CONTAINING GRAPHICS AND SOUND */
 strid_t				blorb_stream;
 
@@ -1385,6 +1392,110 @@ glk_get_bin_line_stream(file_stream, buffer, max_length)
 	return ((glui32) index);
 }
 
+int
+load_program(file_stream)
+	strid_t			file_stream;
+{
+	/* READ THE WHOLE OF THE PROCESSED GAME FILE INTO MEMORY */
+	glsi32			size = 8192;
+	glui32			count;
+	char			*new_text;
+
+	program_length = 0;
+	program_position = 0;
+
+	if ((program_text = (char *) malloc(size)) == NULL) {
+		return (FALSE);
+	}
+
+	glk_stream_set_position(file_stream, 0, seekmode_Start);
+
+	while ((count = glk_get_buffer_stream(file_stream,
+			program_text + program_length,
+			(glui32) (size - program_length))) != 0) {
+		program_length += count;
+
+		if (program_length == size) {
+			/* OUT OF ROOM, DOUBLE THE SIZE OF THE BUFFER */
+			size *= 2;
+			if ((new_text = (char *) realloc(program_text, size)) == NULL) {
+				free(program_text);
+				program_text = NULL;
+				return (FALSE);
+			}
+			program_text = new_text;
+		}
+	}
+
+	return (TRUE);
+}
+
+void
+free_program()
+{
+	if (program_text != NULL) {
+		free(program_text);
+		program_text = NULL;
+	}
+
+	program_length = 0;
+	program_position = 0;
+}
+
+void
+program_seek(position)
+	glsi32			position;
+{
+	program_position = position;
+}
+
+glsi32
+program_tell()
+{
+	return (program_position);
+}
+
+glui32
+program_get_line(buffer, max_length)
+	char *			buffer;
+	glui32			max_length;
+{
+	/* THE IN-MEMORY EQUIVALENT OF glk_get_bin_line_stream: COPY THE NEXT
+	 * LINE, INCLUDING ITS TERMINATING NEWLINE, INTO buffer */
+	char			*start;
+	char			*end;
+	char			*limit;
+	glui32			length;
+
+	if (program_position < 0 || program_position >= program_length) {
+		*buffer = 0;
+		return (0);
+	}
+
+	start = program_text + program_position;
+	limit = program_text + program_length;
+
+	/* LEAVE ROOM FOR THE TERMINATOR */
+	if ((glui32) (limit - start) > max_length - 1) {
+		limit = start + max_length - 1;
+	}
+
+	for (end = start; end < limit; end++) {
+		if (*end == '\n' || *end == '\r') {
+			end++;
+			break;
+		}
+	}
+
+	length = (glui32) (end - start);
+	memcpy(buffer, start, length);
+	*(buffer + length) = 0;
+
+	program_position += length;
+
+	return (length);
+}
+
 void
 jacl_set_window(new_window)
 	winid_t	new_window;
@@ -41,6 +41,11 @@ extern struct string_type		*cstring_table;
 extern struct attribute_type	*attribute_table;
 extern struct function_type		*function_table;
 extern struct function_type		*executing_function;
+extern struct symbol_index		integer_index;
+extern struct symbol_index		cinteger_index;
+extern struct symbol_index		string_index;
+extern struct symbol_index		cstring_index;
+extern struct symbol_index		function_index;
 extern struct command_type		*completion_list;
 extern struct word_type			*grammar_table;
 extern struct synonym_type		*synonym_table;
@@ -258,6 +263,7 @@ read_gamefile()
 	else {
 		current_function = function_table;
 		strcpy(current_function->name, "JACL*Internal");
+		index_symbol(&function_index, current_function->name, current_function);
 		current_function->position = 0;
 		current_function->self = 0;
 		current_function->call_count = 0;
@@ -274,8 +280,8 @@ read_gamefile()
 	strings = 0;
 
 #ifdef GLK
-	glk_stream_set_position(game_stream, (glsi32)start_of_file, seekmode_Start);
-	result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+	program_seek((glsi32)start_of_file);
+	result = program_get_line(text_buffer, (glui32) 1024);
 #else
     fseek(file, start_of_file, SEEK_SET);
     fgets(text_buffer, 1024, file);
@@ -286,7 +292,7 @@ read_gamefile()
 	if (!encrypted && strstr(text_buffer, "#encrypted")) {
 		encrypted = TRUE;
 #ifdef GLK
-		result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+		result = program_get_line(text_buffer, (glui32) 1024);
 #else
 		fgets(text_buffer, 1024, file);
 #endif
@@ -305,7 +311,7 @@ read_gamefile()
 		else if (text_buffer[0] == '{') {
 #ifdef GLK
 			while (result) {
-				result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+				result = program_get_line(text_buffer, (glui32) 1024);
 #else
             while (!feof(file)) {
                 fgets(text_buffer, 1024, file);
@@ -314,7 +320,7 @@ read_gamefile()
 				if (!encrypted && strstr(text_buffer, "#encrypted")) {
 					encrypted = TRUE;
 #ifdef GLK
-					result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+					result = program_get_line(text_buffer, (glui32) 1024);
 #else
                     fgets(text_buffer, 1024, file);
 #endif
@@ -638,7 +644,7 @@ read_gamefile()
 			}
 		}
 #ifdef GLK
-		result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+		result = program_get_line(text_buffer, (glui32) 1024);
 #else
         fgets(text_buffer, 1024, file);
 #endif
@@ -647,7 +653,7 @@ read_gamefile()
 		if (!encrypted && strstr(text_buffer, "#encrypted")) {
 			encrypted = TRUE;
 #ifdef GLK
-			result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+			result = program_get_line(text_buffer, (glui32) 1024);
 #else
         	fgets(text_buffer, 1024, file);
 #endif
@@ -691,8 +697,8 @@ read_gamefile()
 
 	line = 0;
 #ifdef GLK
-	glk_stream_set_position(game_stream, (glsi32)start_of_file, seekmode_Start);
-	result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+	program_seek((glsi32)start_of_file);
+	result = program_get_line(text_buffer, (glui32) 1024);
 #else
     fseek(file, start_of_file, SEEK_SET);
     fgets(text_buffer, 1024, file);
@@ -703,7 +709,7 @@ read_gamefile()
 	if (!encrypted && strstr(text_buffer, "#encrypted")) {
 		encrypted = TRUE;
 #ifdef GLK
-		result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+		result = program_get_line(text_buffer, (glui32) 1024);
 #else
     	fgets(text_buffer, 1024, file);
 #endif
@@ -766,8 +772,9 @@ read_gamefile()
 
 							current_function = function_table;
 							strcpy(current_function->name, function_name);
+							index_symbol(&function_index, current_function->name, current_function);
 #ifdef GLK
-							current_function->position = glk_stream_get_position(game_stream);
+							current_function->position = program_tell();
 #else
                             current_function->position = ftell(file);
 #endif
@@ -788,8 +795,9 @@ read_gamefile()
 
 							current_function = current_function->next_function;
 							strcpy(current_function->name, function_name);
+							index_symbol(&function_index, current_function->name, current_function);
 #ifdef GLK
-							current_function->position = glk_stream_get_position(game_stream);
+							current_function->position = program_tell();
 #else
                             current_function->position = ftell(file);
 #endif
@@ -805,7 +813,7 @@ read_gamefile()
 
 #ifdef GLK
 			while (result) {
-				result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+				result = program_get_line(text_buffer, (glui32) 1024);
 #else
             while (!feof(file)) {
                 fgets(text_buffer, 1024, file);
@@ -815,7 +823,7 @@ read_gamefile()
 				if (!encrypted && strstr(text_buffer, "#encrypted")) {
 					encrypted = TRUE;
 #ifdef GLK
-					result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+					result = program_get_line(text_buffer, (glui32) 1024);
 #else
                 	fgets(text_buffer, 1024, file);
 #endif
@@ -1043,8 +1051,8 @@ read_gamefile()
 		}
 
 #ifdef GLK
-		current_file_position = glk_stream_get_position(game_stream);
-		result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+		current_file_position = program_tell();
+		result = program_get_line(text_buffer, (glui32) 1024);
 #else
         current_file_position = ftell(file);
         fgets(text_buffer, 1024, file);
@@ -1054,7 +1062,7 @@ read_gamefile()
 		if (!encrypted && strstr(text_buffer, "#encrypted")) {
 			encrypted = TRUE;
 #ifdef GLK
-			result = glk_get_bin_line_stream(game_stream, text_buffer, (glui32) 1024);
+			result = program_get_line(text_buffer, (glui32) 1024);
 #else
         	fgets(text_buffer, 1024, file);
 #endif
@@ -1433,6 +1441,9 @@ restart_game()
 	free_from(grammar_table);
 	grammar_table = NULL;
 
+	/* ALL THE SYMBOLS HAVE GONE, SO THEIR INDEXES MUST GO TOO */
+	clear_symbol_indexes();
+
 	read_gamefile();
 }
 
@@ -1476,6 +1487,7 @@ create_cinteger (name, value)
 		current_cinteger = new_cinteger;
 		strncpy(current_cinteger->name, name, 40);
 		current_cinteger->name[40] = 0;
+		index_symbol(&cinteger_index, current_cinteger->name, current_cinteger);
 		current_cinteger->value = value;
 		current_cinteger->next_cinteger = NULL;
 	}
@@ -1504,6 +1516,7 @@ create_integer (name, value)
 		current_integer = new_integer;
 		strncpy(current_integer->name, name, 40);
 		current_integer->name[40] = 0;
+		index_symbol(&integer_index, current_integer->name, current_integer);
 		current_integer->value = value;
 		current_integer->next_integer = NULL;
 	}
@@ -1532,6 +1545,7 @@ create_string (name, value)
 		current_string = new_string;
 		strncpy(current_string->name, name, 40);
 		current_string->name[40] = 0;
+		index_symbol(&string_index, current_string->name, current_string);
 
 		if (value != NULL) {	
 			strncpy(current_string->value, value, 255);
@@ -1565,6 +1579,7 @@ create_cstring (name, value)
 		current_cstring = new_string;
 		strncpy(current_cstring->name, name, 40);
 		current_cstring->name[40] = 0;
+		index_symbol(&cstring_index, current_cstring->name, current_cstring);
 
 		if (value != NULL) {	
 			strncpy(current_cstring->value, value, 255);
@@ -6,6 +6,11 @@
 #ifdef GLK
 strid_t open_glk_file();
 glui32 glk_get_bin_line_stream(); 
+int load_program();
+void free_program();
+void program_seek();
+glsi32 program_tell();
+glui32 program_get_line();
 glui32 parse_utf8();
 void convert_to_utf8(glui32 *text, int len);
 glui32 parse_utf8(unsigned char *buf, glui32 buflen, glui32 *out, glui32 outlen);
@@ -42,6 +47,10 @@ int check_light();
 int find_route();
 int exit_function();
 int	count_resolve();
+void *find_symbol();
+void index_symbol();
+void unindex_symbol();
+void clear_symbol_indexes();
 void jacl_set_window();
 void create_cstring();
 void create_string();
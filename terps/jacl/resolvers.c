@@ -65,6 +65,119 @@ extern int						value_resolved;
 char 							macro_function[84];
 int								value_has_been_resolved;
 
+/* HASH INDEXES OVER THE SYMBOL TABLES, KEPT UP TO DATE BY EVERYTHING THAT
+ * ADDS OR REMOVES A SYMBOL. THE *_resolve_indexed FUNCTIONS START THEIR
+ * SEARCH AT THE FIRST SYMBOL WITH THE REQUESTED NAME RATHER THAN AT THE
+ * HEAD OF THE LIST */
+struct symbol_index				integer_index;
+struct symbol_index				cinteger_index;
+struct symbol_index				string_index;
+struct symbol_index				cstring_index;
+struct symbol_index				function_index;
+
+static unsigned int
+symbol_hash(name)
+	char			*name;
+{
+	unsigned int	hash = 5381;
+
+	while (*name) {
+		hash = (hash * 33) ^ (unsigned char) *name++;
+	}
+
+	return (hash & (SYMBOL_BUCKETS - 1));
+}
+
+void *
+find_symbol(index, name)
+	struct symbol_index	*index;
+	char			*name;
+{
+	struct symbol_entry *entry = index->bucket[symbol_hash(name)];
+
+	while (entry != NULL) {
+		if (!strcmp(name, entry->name))
+			return (entry->symbol);
+		entry = entry->next_entry;
+	}
+
+	return (NULL);
+}
+
+void
+index_symbol(index, name, symbol)
+	struct symbol_index	*index;
+	char			*name;
+	void			*symbol;
+{
+	/* name MUST BE THE NAME STORED IN THE SYMBOL ITSELF. SYMBOLS ARE ALWAYS
+	 * ADDED TO THE END OF THEIR LIST, SO IF THERE IS ALREADY AN ENTRY FOR
+	 * THIS NAME IT STILL POINTS TO THE FIRST ONE */
+	struct symbol_entry *entry;
+	unsigned int	hash;
+
+	if (find_symbol(index, name) != NULL)
+		return;
+
+	if ((entry = (struct symbol_entry *)
+		malloc(sizeof(struct symbol_entry))) == NULL) {
+		outofmem();
+	} else {
+		hash = symbol_hash(name);
+		entry->name = name;
+		entry->symbol = symbol;
+		entry->next_entry = index->bucket[hash];
+		index->bucket[hash] = entry;
+	}
+}
+
+void
+unindex_symbol(index, name)
+	struct symbol_index	*index;
+	char			*name;
+{
+	/* REMOVE THE ENTRY FOR name, ONCE EVERY SYMBOL WITH THAT NAME HAS
+	 * BEEN TAKEN OUT OF ITS LIST */
+	struct symbol_entry **link = &index->bucket[symbol_hash(name)];
+	struct symbol_entry *entry;
+
+	while ((entry = *link) != NULL) {
+		if (!strcmp(name, entry->name)) {
+			*link = entry->next_entry;
+			free(entry);
+			return;
+		}
+		link = &entry->next_entry;
+	}
+}
+
+static void
+clear_symbol_index(index)
+	struct symbol_index	*index;
+{
+	struct symbol_entry *entry;
+	struct symbol_entry *next_entry;
+	int				counter;
+
+	for (counter = 0; counter < SYMBOL_BUCKETS; counter++) {
+		for (entry = index->bucket[counter]; entry != NULL; entry = next_entry) {
+			next_entry = entry->next_entry;
+			free(entry);
+		}
+		index->bucket[counter] = NULL;
+	}
+}
+
+void
+clear_symbol_indexes()
+{
+	clear_symbol_index(&integer_index);
+	clear_symbol_index(&cinteger_index);
+	clear_symbol_index(&string_index);
+	clear_symbol_index(&cstring_index);
+	clear_symbol_index(&function_index);
+}
+
 int            *
 container_resolve(container_name)
 	 char           *container_name;
@@ -423,7 +536,10 @@ integer_resolve_indexed(name, index)
 	char           *name;
 	int				index;
 {
-	struct integer_type *pointer = integer_table;
+	struct integer_type *pointer;
+
+	/* START FROM THE FIRST SYMBOL WITH THIS NAME */
+	pointer = (struct integer_type *) find_symbol(&integer_index, name);
 
 	if (pointer == NULL)
 		return (NULL);
@@ -516,7 +632,10 @@ cinteger_resolve_indexed(name, index)
 	char           *name;
 	int				index;
 {
-	struct cinteger_type *pointer = cinteger_table;
+	struct cinteger_type *pointer;
+
+	/* START FROM THE FIRST SYMBOL WITH THIS NAME */
+	pointer = (struct cinteger_type *) find_symbol(&cinteger_index, name);
 
 	if (pointer == NULL)
 		return (NULL);
@@ -600,7 +719,10 @@ string_resolve_indexed(name, index)
 	char           *name;
 	int				index;
 {
-	struct string_type *pointer = string_table;
+	struct string_type *pointer;
+
+	/* START FROM THE FIRST SYMBOL WITH THIS NAME */
+	pointer = (struct string_type *) find_symbol(&string_index, name);
 
 	if (pointer == NULL)
 		return (NULL);
@@ -684,7 +806,10 @@ cstring_resolve_indexed(name, index)
 	 char           *name;
 	int				index;
 {
-	struct string_type *pointer = cstring_table;
+	struct string_type *pointer;
+
+	/* START FROM THE FIRST SYMBOL WITH THIS NAME */
+	pointer = (struct string_type *) find_symbol(&cstring_index, name);
 
 	if (pointer == NULL)
 		return (NULL);
@@ -716,8 +841,6 @@ function_resolve(name)
 	char			core_name[84];
 	int				index;
 
-	struct function_type *pointer = function_table;
-
 	if (function_table == NULL)
 		return (NULL);
 
@@ -737,18 +860,9 @@ function_resolve(name)
 	 * THE FUNCTION */
 	full_name = (char *) expand_function(core_name);
 
-	/* LOOP THROUGH ALL THE FUNCTIONS LOOKING FOR A FUNCTION THAT
-	 * HAS THIS EXPANDED FULL NAME */
-	do {
-		if (!strcmp(full_name, pointer->name))
-			return (pointer);
-		else
-			pointer = pointer->next_function;
-	}
-	while (pointer != NULL);
-
-	/* RETURN A POINTER TO THE STRUCTURE THAT ENCAPSULATES THE FUNCTION */
-	return (NULL);
+	/* RETURN A POINTER TO THE STRUCTURE THAT ENCAPSULATES THE FUNCTION
+	 * THAT HAS THIS EXPANDED FULL NAME */
+	return ((struct function_type *) find_symbol(&function_index, full_name));
 }
 
 char *
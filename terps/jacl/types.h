@@ -120,6 +120,18 @@ struct function_type {
 	struct function_type *next_function;
 };
 
+// A HASH INDEX OVER ONE OF THE SYMBOL TABLES. EACH ENTRY POINTS TO THE
+// FIRST SYMBOL IN THE TABLE WITH A GIVEN NAME
+struct symbol_entry {
+	char			*name;
+	void			*symbol;
+	struct symbol_entry *next_entry;
+};
+
+struct symbol_index {
+	struct symbol_entry *bucket[SYMBOL_BUCKETS];
+};
+
 struct command_type {
     char            word[44];
     struct command_type *next;
@@ -1509,6 +1509,10 @@ gln_graphics_close (void)
     {
       glk_window_close (gln_graphics_window, NULL);
       gln_graphics_window = NULL;
+
+      /* Nothing is on screen any more; forget what was painted. */
+      free (gln_graphics_on_screen);
+      gln_graphics_on_screen = NULL;
     }
 }
 
@@ -2147,27 +2151,52 @@ break_y_max:
     }
 }
 
+/*
+ * gln_graphics_paint_everything()
+ *
+ * Paint every pixel that differs between the off-screen and on-screen
+ * buffers, as runs of same-colored pixels along each row, so that each run
+ * is a single Glk rectangle fill.  The on-screen buffer is updated to match.
+ */
 static void
 gln_graphics_paint_everything (winid_t glk_window,
 			glui32 palette[],
 			gln_byte off_screen[],
+			gln_byte on_screen[],
 			int x_offset, int y_offset,
 			gln_uint16 width, gln_uint16 height)
 {
 	gln_byte		pixel;			/* Reference pixel color */
-	int		x, y;
+	long		index_row;
+	int		x, y, run;
 
+	index_row = 0;
 	for (y = 0; y < height; y++)
 	{
-	    for (x = 0; x < width; x ++)
+	    x = 0;
+	    while (x < width)
 	    {
-		pixel = off_screen[ y * width + x ];
+		pixel = off_screen[ index_row + x ];
+		if (on_screen[ index_row + x ] == pixel)
+		{
+		    x++;
+		    continue;
+		}
+
+		for (run = x + 1;
+		     run < width && off_screen[ index_row + run ] == pixel;
+		     run++)
+		    ;
+
 		glk_window_fill_rect (glk_window,
 			palette[ pixel ],
 			x * GLN_GRAPHICS_PIXEL + x_offset,
 			y * GLN_GRAPHICS_PIXEL + y_offset,
-			GLN_GRAPHICS_PIXEL, GLN_GRAPHICS_PIXEL);
+			(run - x) * GLN_GRAPHICS_PIXEL, GLN_GRAPHICS_PIXEL);
+		memset (on_screen + index_row + x, pixel, run - x);
+		x = run;
 	    }
+	    index_row += width;
 	}
 }
 
@@ -2204,6 +2233,7 @@ gln_graphics_timeout (void)
   static int saved_x, saved_y;               /* Saved x,y coord */
 
   static int total_regions;                  /* Debug statistic */
+  static long on_screen_size;                /* Pixels in on_screen */
 
   gln_byte *on_screen;                       /* On-screen image buffer */
   gln_byte *off_screen;                      /* Off-screen image buffer */
@@ -2211,6 +2241,8 @@ gln_graphics_timeout (void)
   int layer;                                 /* Image layer iterator */
   int x, y;                                  /* Image iterators */
   int regions;                               /* Count of regions painted */
+  int palette_changed = TRUE;                /* New picture palette differs */
+  int repaint_all = TRUE;                    /* Invalidate on-screen pixels */
 
   /* Ignore the call if the current graphics state is inactive. */
   if (!gln_graphics_active)
@@ -2271,9 +2303,15 @@ gln_graphics_timeout (void)
 
       /*
        * Pre-convert all the picture palette colors into their corresponding
-       * Glk colors.
+       * Glk colors, noting whether they differ from the last picture's.
        */
-      gln_graphics_convert_palette (gln_graphics_palette, palette);
+      {
+        glui32 old_palette[GLN_PALETTE_SIZE];
+
+        memcpy (old_palette, palette, sizeof (palette));
+        gln_graphics_convert_palette (gln_graphics_palette, palette);
+        palette_changed = memcmp (old_palette, palette, sizeof (palette)) != 0;
+      }
 
       /* Save the color count for possible queries later. */
       gln_graphics_color_count =
@@ -2291,6 +2329,8 @@ gln_graphics_timeout (void)
    */
   if (gln_graphics_new_picture || deferred_repaint)
     {
+      int old_x_offset = x_offset, old_y_offset = y_offset;
+
       /*
        * Calculate the x and y offset to center the picture in the graphics
        * window.
@@ -2300,18 +2340,33 @@ gln_graphics_timeout (void)
                                      gln_graphics_width, gln_graphics_height,
                                      &x_offset, &y_offset);
 
+#ifdef GARGLK
+      /*
+       * If a new picture lands in the same place as the last one and uses
+       * the same colors, what is already on screen is still valid, so keep
+       * it; only the pixels that differ then get painted.
+       */
+      repaint_all = deferred_repaint || palette_changed || !on_screen
+                    || on_screen_size != picture_size
+                    || x_offset != old_x_offset || y_offset != old_y_offset;
+#endif
+
       /*
        * Reset all on-screen pixels to an unused value, guaranteed not to
        * match any in a real picture.  This forces all pixels to be repainted
        * on a buffer/on-screen comparison.
        */
-      free (on_screen);
-      on_screen = gln_malloc (picture_size * sizeof (*on_screen));
-      memset (on_screen, GLN_GRAPHICS_UNUSED_PIXEL,
-              picture_size * sizeof (*on_screen));
-
-      /* Note the buffer for freeing on cleanup. */
-      gln_graphics_on_screen = on_screen;
+      if (repaint_all)
+        {
+          free (on_screen);
+          on_screen = gln_malloc (picture_size * sizeof (*on_screen));
+          memset (on_screen, GLN_GRAPHICS_UNUSED_PIXEL,
+                  picture_size * sizeof (*on_screen));
+          on_screen_size = picture_size;
+
+          /* Note the buffer for freeing on cleanup. */
+          gln_graphics_on_screen = on_screen;
+        }
 
       /*
        * Assign new layers to the current image.  This sorts colors by usage
@@ -2326,10 +2381,11 @@ gln_graphics_timeout (void)
 #endif
 
       /* Clear the graphics window. */
-      gln_graphics_clear_and_border (gln_graphics_window,
-                                     x_offset, y_offset,
-                                     GLN_GRAPHICS_PIXEL,
-                                     gln_graphics_width, gln_graphics_height);
+      if (repaint_all)
+        gln_graphics_clear_and_border (gln_graphics_window,
+                                       x_offset, y_offset,
+                                       GLN_GRAPHICS_PIXEL,
+                                       gln_graphics_width, gln_graphics_height);
 
       /* Start a fresh picture rendering pass. */
       yield_counter = 0;
@@ -2442,7 +2498,7 @@ gln_graphics_timeout (void)
 #else
   gln_graphics_paint_everything
       (gln_graphics_window,
-       palette, off_screen,
+       palette, off_screen, on_screen,
        x_offset, y_offset,
        gln_graphics_width,
        gln_graphics_height);
@@ -2841,6 +2897,40 @@ static gln_linegraphics_segment_t * gln_linegraphics_fill_segments = NULL;
 static int gln_linegraphics_fill_segments_allocation = 0,
            gln_linegraphics_fill_segments_length = 0;
 
+/*
+ * Drawing operations received since the graphics were last cleared.  These
+ * are recorded rather than drawn immediately, and rasterized when the
+ * picture is complete, so that a picture drawn before can be taken from
+ * the cache below instead.  Each operation is GLN_LINEGRAPHICS_OP_SIZE ints,
+ * an opcode and its arguments, and the array grows like the fill segments.
+ */
+enum { GLN_LINEGRAPHICS_SET_COLOR, GLN_LINEGRAPHICS_DRAW_LINE,
+       GLN_LINEGRAPHICS_FILL };
+enum { GLN_LINEGRAPHICS_OP_SIZE = 7 };
+static int * gln_linegraphics_ops = NULL;
+static int gln_linegraphics_ops_allocation = 0,
+           gln_linegraphics_ops_length = 0;
+static int gln_linegraphics_ops_pending = FALSE;
+
+/*
+ * Cache of rasterized pictures, keyed by the complete list of drawing
+ * operations that produced them; the list encodes both the picture and
+ * its palette.  Entries are replaced round-robin once the cache is full.
+ */
+enum { GLN_LINEGRAPHICS_CACHE_SIZE = 32 };
+typedef struct
+{
+  int *ops;                           /* Drawing operations, NULL if unused */
+  int ops_length;                     /* Length of operations in ints */
+  gln_uint16 width, height;           /* Bitmap dimensions */
+  gln_byte *bitmap;                   /* Rasterized picture */
+  Colour palette[GLN_PALETTE_SIZE];   /* Picture palette */
+} gln_linegraphics_cache_entry_t;
+
+static gln_linegraphics_cache_entry_t
+    gln_linegraphics_cache[GLN_LINEGRAPHICS_CACHE_SIZE];
+static int gln_linegraphics_cache_next = 0;
+
 
 /*
  * gln_linegraphics_create_context()
@@ -2871,6 +2961,10 @@ gln_linegraphics_create_context (void)
 
   /* Set graphics picture number to -1; this is not a real game bitmap. */
   gln_graphics_picture = -1;
+
+  /* Discard any drawing operations not yet rasterized. */
+  gln_linegraphics_ops_length = 0;
+  gln_linegraphics_ops_pending = FALSE;
 }
 
 
@@ -3057,7 +3151,8 @@ gln_linegraphics_draw_line_if (int x1, int y1, int x2, int y2,
  * 
  * The main modification is to make segment stacks growable, through the
  * helper push and pop functions.  There is also a small adaptation to
- * check explicitly for color2, to meet the Level 9 API.
+ * check explicitly for color2, to meet the Level 9 API.  Scan lines are
+ * examined through a row pointer, and each span found is set in one go.
  */
 static void
 gln_linegraphics_push_fill_segment (int y, int xl, int xr, int dy)
@@ -3119,7 +3214,8 @@ gln_linegraphics_fill_4way_if (int x, int y, int colour1, int colour2)
   /* Clip fill requests to visible graphics region. */
   if (x >= 0 && x < gln_graphics_width && y >= 0 && y < gln_graphics_height)
     {
-      int left, x1, x2, dy, x_lo, x_hi;
+      int left, x1, x2, dy, x_lo, x_hi, span;
+      gln_byte *row;
 
       /*
        * Level 9 API; explicit check for a match against colour2.  This also
@@ -3153,12 +3249,11 @@ gln_linegraphics_fill_4way_if (int x, int y, int colour1, int colour2)
            * Segment of scan line y-dy for x1<=x<=x2 was previously filled,
            * now explore adjacent pixels in scan line y.
            */
-          for (x = x1;
-               x >= x_lo && gln_linegraphics_get_pixel (x, y) == colour2;
-               x--)
-            {
-              gln_linegraphics_set_pixel (x, y, colour1);
-            }
+          row = gln_graphics_bitmap + y * gln_graphics_width;
+          for (x = x1; x >= x_lo && row[x] == colour2; x--)
+            ;
+          if (x < x1)
+            memset (row + x + 1, colour1, x1 - x);
 
           if (x >= x1)
             goto skip;
@@ -3173,12 +3268,10 @@ gln_linegraphics_fill_4way_if (int x, int y, int colour1, int colour2)
           x = x1 + 1;
           do
             {
-              for (;
-                   x <= x_hi && gln_linegraphics_get_pixel (x, y) == colour2;
-                   x++)
-                {
-                  gln_linegraphics_set_pixel (x, y, colour1);
-                }
+              for (span = x; x <= x_hi && row[x] == colour2; x++)
+                ;
+              if (x > span)
+                memset (row + span, colour1, x - span);
 
               gln_linegraphics_push_fill_segment (y, left, x - 1, dy);
 
@@ -3188,9 +3281,7 @@ gln_linegraphics_fill_4way_if (int x, int y, int colour1, int colour2)
                   gln_linegraphics_push_fill_segment (y, x2 + 1, x - 1, -dy);
                 }
 
-skip:         for (x++;
-                   x <= x2 && gln_linegraphics_get_pixel (x, y) != colour2;
-                   x++)
+skip:         for (x++; x <= x2 && row[x] != colour2; x++)
                 ;
 
               left = x;
@@ -3201,6 +3292,137 @@ skip:         for (x++;
 }
 
 
+/*
+ * gln_linegraphics_record_op()
+ *
+ * Append a drawing operation to the list pending rasterization.
+ */
+static void
+gln_linegraphics_record_op (int opcode, int arg1, int arg2, int arg3,
+                            int arg4, int arg5, int arg6)
+{
+  int *op;
+
+  /* Grow the operations array if required, successively doubling. */
+  if (gln_linegraphics_ops_length + GLN_LINEGRAPHICS_OP_SIZE
+      > gln_linegraphics_ops_allocation)
+    {
+      int allocation;
+
+      allocation = gln_linegraphics_ops_allocation == 0
+                   ? GLN_LINEGRAPHICS_OP_SIZE * 64
+                   : gln_linegraphics_ops_allocation << 1;
+      gln_linegraphics_ops = gln_realloc (gln_linegraphics_ops,
+                                          allocation
+                                          * sizeof (*gln_linegraphics_ops));
+      gln_linegraphics_ops_allocation = allocation;
+    }
+
+  op = gln_linegraphics_ops + gln_linegraphics_ops_length;
+  op[0] = opcode;
+  op[1] = arg1;
+  op[2] = arg2;
+  op[3] = arg3;
+  op[4] = arg4;
+  op[5] = arg5;
+  op[6] = arg6;
+  gln_linegraphics_ops_length += GLN_LINEGRAPHICS_OP_SIZE;
+  gln_linegraphics_ops_pending = TRUE;
+}
+
+
+/*
+ * gln_linegraphics_rasterize()
+ *
+ * Bring the bitmap and palette up to date with the recorded drawing
+ * operations, either from the cache of previously drawn pictures, or by
+ * drawing them and adding the result to the cache.
+ */
+static void
+gln_linegraphics_rasterize (void)
+{
+  gln_linegraphics_cache_entry_t *entry;
+  long picture_bytes;
+  int index;
+
+  if (!gln_linegraphics_ops_pending)
+    return;
+  gln_linegraphics_ops_pending = FALSE;
+
+  picture_bytes = gln_graphics_width
+                  * gln_graphics_height * sizeof (*gln_graphics_bitmap);
+
+  /* Look for the same operations on the same size bitmap in the cache. */
+  for (index = 0; index < GLN_LINEGRAPHICS_CACHE_SIZE; index++)
+    {
+      entry = gln_linegraphics_cache + index;
+      if (entry->ops
+          && entry->ops_length == gln_linegraphics_ops_length
+          && entry->width == gln_graphics_width
+          && entry->height == gln_graphics_height
+          && memcmp (entry->ops, gln_linegraphics_ops,
+                     gln_linegraphics_ops_length
+                     * sizeof (*gln_linegraphics_ops)) == 0)
+        {
+          memcpy (gln_graphics_bitmap, entry->bitmap, picture_bytes);
+          memcpy (gln_graphics_palette, entry->palette,
+                  sizeof (gln_graphics_palette));
+          return;
+        }
+    }
+
+  /* Not cached, so draw the picture from a cleared context. */
+  gln_linegraphics_clear_context ();
+  for (index = 0;
+       index < gln_linegraphics_ops_length;
+       index += GLN_LINEGRAPHICS_OP_SIZE)
+    {
+      const int *op = gln_linegraphics_ops + index;
+
+      switch (op[0])
+        {
+        case GLN_LINEGRAPHICS_SET_COLOR:
+          gln_linegraphics_set_palette_color (op[1], op[2]);
+          break;
+
+        case GLN_LINEGRAPHICS_DRAW_LINE:
+          gln_linegraphics_draw_line_if (op[1], op[2], op[3], op[4],
+                                         op[5], op[6]);
+          break;
+
+        case GLN_LINEGRAPHICS_FILL:
+          gln_linegraphics_fill_4way_if (op[1], op[2], op[3], op[4]);
+          break;
+
+        default:
+          gln_fatal ("GLK: Invalid line graphics operation");
+          glk_exit ();
+        }
+    }
+
+  /* A blank picture is cheaper to redraw than to look up. */
+  if (gln_linegraphics_ops_length == 0)
+    return;
+
+  /* Add the picture to the cache, replacing the oldest entry if full. */
+  entry = gln_linegraphics_cache + gln_linegraphics_cache_next;
+  gln_linegraphics_cache_next = (gln_linegraphics_cache_next + 1)
+                                % GLN_LINEGRAPHICS_CACHE_SIZE;
+
+  free (entry->ops);
+  free (entry->bitmap);
+  entry->ops_length = gln_linegraphics_ops_length;
+  entry->ops = gln_malloc (entry->ops_length * sizeof (*entry->ops));
+  memcpy (entry->ops, gln_linegraphics_ops,
+          entry->ops_length * sizeof (*entry->ops));
+  entry->width = gln_graphics_width;
+  entry->height = gln_graphics_height;
+  entry->bitmap = gln_malloc (picture_bytes);
+  memcpy (entry->bitmap, gln_graphics_bitmap, picture_bytes);
+  memcpy (entry->palette, gln_graphics_palette, sizeof (entry->palette));
+}
+
+
 /*
  * os_cleargraphics()
  * os_setcolour()
@@ -3208,34 +3430,41 @@ skip:         for (x++;
  * os_fill()
  *
  * Interpreter entry points for line drawing graphics.  All calls to these
- * are ignored if line drawing mode is not set.
+ * are ignored if line drawing mode is not set.  Drawing is recorded for
+ * gln_linegraphics_rasterize(); clearing discards anything recorded.
  */
 void
 os_cleargraphics (void)
 {
   if (gln_graphics_interpreter_state == GLN_GRAPHICS_LINE_MODE)
-    gln_linegraphics_clear_context ();
+    {
+      gln_linegraphics_ops_length = 0;
+      gln_linegraphics_ops_pending = TRUE;
+    }
 }
 
 void
 os_setcolour (int colour, int index)
 {
   if (gln_graphics_interpreter_state == GLN_GRAPHICS_LINE_MODE)
-    gln_linegraphics_set_palette_color (colour, index);
+    gln_linegraphics_record_op (GLN_LINEGRAPHICS_SET_COLOR,
+                                colour, index, 0, 0, 0, 0);
 }
 
 void
 os_drawline (int x1, int y1, int x2, int y2, int colour1, int colour2)
 {
   if (gln_graphics_interpreter_state == GLN_GRAPHICS_LINE_MODE)
-    gln_linegraphics_draw_line_if (x1, y1, x2, y2, colour1, colour2);
+    gln_linegraphics_record_op (GLN_LINEGRAPHICS_DRAW_LINE,
+                                x1, y1, x2, y2, colour1, colour2);
 }
 
 void
 os_fill (int x, int y, int colour1, int colour2)
 {
   if (gln_graphics_interpreter_state == GLN_GRAPHICS_LINE_MODE)
-    gln_linegraphics_fill_4way_if (x, y, colour1, colour2);
+    gln_linegraphics_record_op (GLN_LINEGRAPHICS_FILL,
+                                x, y, colour1, colour2, 0, 0);
 }
 
 
@@ -3263,6 +3492,9 @@ gln_linegraphics_process (void)
           glk_tick ();
         }
 
+      /* Draw the resulting picture, or fetch it from the cache. */
+      gln_linegraphics_rasterize ();
+
       /* 
        * If graphics is enabled and we created an image with graphics
        * opcodes above, open a graphics window and start bitmap display.
@@ -3289,11 +3521,28 @@ gln_linegraphics_process (void)
 static void
 gln_linegraphics_cleanup (void)
 {
+  int index;
+
   free (gln_linegraphics_fill_segments);
   gln_linegraphics_fill_segments = NULL;
 
   gln_linegraphics_fill_segments_allocation = 0;
   gln_linegraphics_fill_segments_length = 0;
+
+  free (gln_linegraphics_ops);
+  gln_linegraphics_ops = NULL;
+
+  gln_linegraphics_ops_allocation = 0;
+  gln_linegraphics_ops_length = 0;
+  gln_linegraphics_ops_pending = FALSE;
+
+  for (index = 0; index < GLN_LINEGRAPHICS_CACHE_SIZE; index++)
+    {
+      free (gln_linegraphics_cache[index].ops);
+      free (gln_linegraphics_cache[index].bitmap);
+    }
+  memset (gln_linegraphics_cache, 0, sizeof (gln_linegraphics_cache));
+  gln_linegraphics_cache_next = 0;
 }
 
 
@@ -6159,12 +6408,13 @@ __wrap_tolower (int ch)
 /*---------------------------------------------------------------------*/
 
 /*
- * Watchdog timeout -- we'll wait for five seconds of silence from the core
- * interpreter before offering to stop the game forcibly, and we'll check
- * it every 10,240 opcodes.
+ * Game opcodes are run in slices of up to 1,024 opcodes.  Watchdog timeout
+ * -- we'll wait for five seconds of silence from the core interpreter before
+ * offering to stop the game forcibly, and we'll check it every ten slices.
  */
+static const int GLN_SLICE_BUDGET = 1024;
 static const int GLN_WATCHDOG_TIMEOUT = 5,
-                 GLN_WATCHDOG_PERIOD = 10240;
+                 GLN_WATCHDOG_PERIOD = 10;
 
 /*
  * The following values need to be passed between the startup_code and main
@@ -6527,10 +6777,12 @@ gln_main (void)
       /* Start, or restart, watchdog checking. */
       gln_watchdog_start (GLN_WATCHDOG_TIMEOUT, GLN_WATCHDOG_PERIOD);
 
-      /* Run the game until StopGame called, or RunGame() returns FALSE. */
+      /*
+       * Run the game until StopGame called, or RunGameSlice() returns FALSE.
+       */
       do
         {
-          is_running = RunGame ();
+          is_running = RunGameSlice (GLN_SLICE_BUDGET);
           glk_tick ();
 
           /* Poll for watchdog timeout. */
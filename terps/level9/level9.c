@@ -111,6 +111,7 @@ GameState workspace;
 L9UINT16 randomseed;
 L9UINT16 constseed=0;
 L9BOOL Running;
+L9BOOL SliceEnd;
 
 char ibuff[IBUFFSIZE];
 L9BYTE* ibuffptr;
@@ -2804,6 +2805,8 @@ void input(void)
 	   next time around instructionloop, this is used when save() and restore()
 	   are called out of line */
 
+	SliceEnd=TRUE;
+
 	codeptr--;
 	if (L9GameType<=L9_V2)
 	{
@@ -3837,6 +3840,24 @@ void listhandler(void)
 	}
 }
 
+static void illegalinstruction(void)
+{
+	ilins(code & 0x1f);
+}
+
+/* handlers for instructions 0-31 */
+static void (*const instructions[32])(void) =
+{
+	Goto,intgosub,intreturn,printnumber,
+	messagev,messagec,function,input,
+	varcon,varvar,_add,_sub,
+	illegalinstruction,illegalinstruction,jump,Exit,
+	ifeqvt,ifnevt,ifltvt,ifgtvt,
+	_screen,cleartg,picture,getnextobject,
+	ifeqct,ifnect,ifltct,ifgtct,
+	printinput,illegalinstruction,illegalinstruction,illegalinstruction
+};
+
 void executeinstruction(void)
 {
 #ifdef CODEFOLLOW
@@ -3849,43 +3870,7 @@ void executeinstruction(void)
 	if (code & 0x80)
 		listhandler();
 	else
-	{
-		switch (code & 0x1f)
-		{
-			case 0:		Goto();break;
-			case 1: 	intgosub();break;
-			case 2:		intreturn();break;
-			case 3:		printnumber();break;
-			case 4:		messagev();break;
-			case 5:		messagec();break;
-			case 6:		function();break;
-			case 7:		input();break;
-			case 8:		varcon();break;
-			case 9:		varvar();break;
-			case 10:	_add();break;
-			case 11:	_sub();break;
-			case 12:	ilins(code & 0x1f);break;
-			case 13:	ilins(code & 0x1f);break;
-			case 14:	jump();break;
-			case 15:	Exit();break;
-			case 16:	ifeqvt();break;
-			case 17:	ifnevt();break;
-			case 18:	ifltvt();break;
-			case 19:	ifgtvt();break;
-			case 20:	_screen();break;
-			case 21:	cleartg();break;
-			case 22:	picture();break;
-			case 23:	getnextobject();break;
-			case 24:	ifeqct();break;
-			case 25:	ifnect();break;
-			case 26:	ifltct();break;
-			case 27:	ifgtct();break;
-			case 28:	printinput();break;
-			case 29:	ilins(code & 0x1f);break;
-			case 30:	ilins(code & 0x1f);break;
-			case 31:	ilins(code & 0x1f);break;
-		}
-	}
+		instructions[code & 0x1f]();
 #ifdef CODEFOLLOW
 	fprintf(f,"\n");
 	fclose(f);
@@ -3942,6 +3927,18 @@ L9BOOL RunGame(void)
 	return Running;
 }
 
+/* run up to budget instructions, returning early after input */
+L9BOOL RunGameSlice(int budget)
+{
+	SliceEnd=FALSE;
+	while (Running && !SliceEnd && budget-- > 0)
+	{
+		code=*codeptr++;
+		executeinstruction();
+	}
+	return Running;
+}
+
 void RestoreGame(char* filename)
 {
 	int Bytes;
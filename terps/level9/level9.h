@@ -125,6 +125,7 @@ FILE* os_open_script_file(void);
 /* routines provided by level9 interpreter */
 L9BOOL LoadGame(char* filename, char* picname);
 L9BOOL RunGame(void);
+L9BOOL RunGameSlice(int budget);
 void StopGame(void);
 void RestoreGame(char* filename);
 void FreeMemory(void);
@@ -432,6 +432,22 @@ type8 ms_init(type8s * name, type8s * gfxname, type8s * hntname, type8s * sndnam
 
 type8 ms_rungame(void);
 
+/****************************************************************************\
+* Function: ms_runslice
+*
+* Purpose: Executes a batch of interpreter instructions
+*
+* Parameters:   type32 budget           maximum number of instructions
+*
+* Return: True if successful
+*
+* Note: Returns early once the game has read a line or key, so that the
+*       caller can handle any pending events between turns:
+*       while (running) {running=ms_runslice(budget);}
+\****************************************************************************/
+
+type8 ms_runslice(type32 budget);
+
 /****************************************************************************\
 * Function: ms_freemen
 *
@@ -289,6 +289,7 @@ type8 *arg1, *arg2, is_reversible, running = 0, tmparg[4] = {0, 0, 0, 0};
 type8 lastchar = 0, version = 0, sd = 0;
 type8 *decode_table, *restart = 0, *code = 0, *string = 0, *string2 = 0;
 type8 *string3 = 0, *dict = 0;
+type8 slice_end = 0;
 type8 quick_flag = 0, gfx_ver = 0, *gfx_buf = 0, *gfx_data = 0;
 type8 *gfx2_hdr = 0, *gfx2_buf = 0;
 type8s *gfx2_name = 0;
@@ -300,11 +301,37 @@ FILE *snd_fp = 0;
 
 const type8s undo_ok[] = "\n[Previous turn undone.]";
 const type8s undo_fail[] = "\n[You can't \"undo\" what hasn't been done!]";
-type32 undo_regs[2][18], undo_pc, undo_size;
-type8 *undo[2] = {0, 0}, undo_stat[2] = {0, 0};
+type32 undo_pc, undo_size;
 type16 gfxtable = 0, table_dist = 0;
 type16 v4_id = 0, next_table = 1;
 
+/* Undo keeps a copy of game memory as it was at the latest undo point,
+   plus a ring of earlier turns. Each ring entry holds the registers of
+   a turn and its memory as runs of bytes XORed with the following turn,
+   so applying an entry to the copy steps it back by one turn. */
+
+#ifndef UNDO_DEPTH
+#define UNDO_DEPTH 32	/* maximum number of turns that can be undone */
+#endif
+#ifndef UNDO_MEMORY
+#define UNDO_MEMORY 0x100000L	/* memory budget for the undo ring */
+#endif
+
+struct undo_turn
+{
+	type8 *diff;
+	type32 diff_size;
+	type32 regs[18];
+};
+
+type8 *undo_base = 0, undo_valid = 0, undo_skip = 0;
+type32 undo_base_regs[18];
+struct undo_turn undo_ring[UNDO_DEPTH];
+type16 undo_first = 0, undo_count = 0;
+type32 undo_memory = 0;
+type8 *undo_scratch = 0;
+type32 undo_scratch_size = 0;
+
 struct picture
 {
 	type8 * data;
@@ -364,6 +391,7 @@ FILE *dbg_log;
 /* prototypes */
 type32 read_reg(int, int);
 void write_reg(int, int, type32);
+void clear_undo(void);
 
 #define MAX_STRING_SIZE  0xFF00
 #define MAX_PICTURE_SIZE 0xC800
@@ -471,13 +499,15 @@ void ms_freemem(void)
 		free(string3);
 	if (dict)
 		free(dict);
-	if (undo[0])
-		free(undo[0]);
-	if (undo[1])
-		free(undo[1]);
+	clear_undo();
+	if (undo_base)
+		free(undo_base);
+	if (undo_scratch)
+		free(undo_scratch);
+	undo_scratch_size = 0;
 	if (restart)
 		free(restart);
-	code = string = string2 = string3 = dict = undo[0] = undo[1] = restart = 0;
+	code = string = string2 = string3 = dict = undo_base = undo_scratch = restart = 0;
 	if (gfx_data)
 		free(gfx_data);
 	if (gfx_buf)
@@ -672,13 +702,13 @@ type8 ms_init(type8s * name, type8s * gfxname, type8s * hntname, type8s * sndnam
 		else
 		{
 			memcpy(code, restart, undo_size);
-			undo_stat[0] = undo_stat[1] = 0;
+			clear_undo();
 			ms_showpic(0, 0);
 		}
 	}
 	else
 	{
-		undo_stat[0] = undo_stat[1] = 0;
+		clear_undo();
 		ms_seed((type32)time(0));
 		if (!(fp = fopen(name, "rb")))
 			return 0;
@@ -740,7 +770,7 @@ type8 ms_init(type8s * name, type8s * gfxname, type8s * hntname, type8s * sndnam
 				return 0;
 			}
 		}
-		if (!(undo[0] = malloc(undo_size)) || !(undo[1] = malloc(undo_size)))
+		if (!(undo_base = malloc(undo_size)))
 		{
 			ms_freemem();
 			fclose(fp);
@@ -1513,52 +1543,171 @@ type8 *sound_extract(type8s * name, type32 * length, type16 * tempo)
 	return 0;
 }
 
+/* forget all saved turns */
+
+void clear_undo(void)
+{
+	while (undo_count)
+	{
+		free(undo_ring[undo_first].diff);
+		undo_first = (undo_first + 1) % UNDO_DEPTH;
+		undo_count--;
+	}
+	undo_first = 0;
+	undo_memory = 0;
+	undo_valid = undo_skip = 0;
+}
+
+void drop_oldest_undo(void)
+{
+	free(undo_ring[undo_first].diff);
+	undo_memory -= undo_ring[undo_first].diff_size;
+	undo_first = (undo_first + 1) % UNDO_DEPTH;
+	undo_count--;
+}
+
+/* make room in the scratch buffer for another n bytes of diff */
+
+type8 undo_reserve(type32 used, type32 n)
+{
+	type8 *tmp;
+	type32 size;
+
+	if (used + n <= undo_scratch_size)
+		return 1;
+	size = undo_scratch_size ? undo_scratch_size : 0x1000;
+	while (used + n > size)
+		size *= 2;
+	if (!(tmp = realloc(undo_scratch, size)))
+		return 0;
+	undo_scratch = tmp;
+	undo_scratch_size = size;
+	return 1;
+}
+
+/* Encode the difference between undo_base and code as a list of runs:
+   a 16-bit count of equal bytes to skip, a 16-bit count of changed bytes,
+   then the changed bytes XORed together. undo_base is updated to match
+   code as it goes. Returns the encoded size, or -1 if out of memory. */
+
+long encode_undo(void)
+{
+	type32 i = 0, used = 0, skip, len;
+
+	while (i < undo_size)
+	{
+		for (skip = 0; i < undo_size && skip < 0xffff && code[i] == undo_base[i]; skip++)
+			i++;
+		if (i == undo_size)
+			break;	/* only equal bytes left */
+		for (len = 0; i + len < undo_size && len < 0xffff && code[i + len] != undo_base[i + len]; len++)
+			;
+		if (!undo_reserve(used, 4 + len))
+			return -1;
+		write_w(undo_scratch + used, (type16)skip);
+		write_w(undo_scratch + used + 2, (type16)len);
+		used += 4;
+		for (; len; len--, i++)
+		{
+			undo_scratch[used++] = code[i] ^ undo_base[i];
+			undo_base[i] = code[i];
+		}
+	}
+	return (long)used;
+}
+
+/* apply an encoded difference to undo_base */
+
+void decode_undo(type8 * diff, type32 size)
+{
+	type32 i = 0, pos = 0, len;
+
+	while (pos < size)
+	{
+		i += read_w(diff + pos);
+		len = read_w(diff + pos + 2);
+		pos += 4;
+		for (; len; len--)
+			undo_base[i++] ^= diff[pos++];
+	}
+}
+
 void save_undo(void)
 {
-	type8 *tmp, i;
-	type32 tmp32;
+	struct undo_turn *turn;
+	type8 i, *diff = 0;
+	long size;
 
-	tmp = undo[0];	/* swap buffers */
-	undo[0] = undo[1];
-	undo[1] = tmp;
+	if (undo_skip)
+	{
+		/* just undone: memory and registers already match undo_base */
+		undo_skip = 0;
+		return;
+	}
 
-	for (i = 0; i < 18; i++)
+	if (undo_valid)
 	{
-		tmp32 = undo_regs[0][i];
-		undo_regs[0][i] = undo_regs[1][i];
-		undo_regs[1][i] = tmp32;
+		if ((size = encode_undo()) < 0 || (size && !(diff = malloc(size))))
+		{
+			/* out of memory, start over from this turn */
+			clear_undo();
+			memcpy(undo_base, code, undo_size);
+			size = -1;
+		}
+		if (size >= 0)
+		{
+			if (size)
+				memcpy(diff, undo_scratch, size);
+			if (undo_count == UNDO_DEPTH)
+				drop_oldest_undo();
+			turn = &undo_ring[(undo_first + undo_count) % UNDO_DEPTH];
+			turn->diff = diff;
+			turn->diff_size = size;
+			memcpy(turn->regs, undo_base_regs, sizeof(undo_base_regs));
+			undo_count++;
+			undo_memory += size;
+			while (undo_count > 1 && undo_memory > UNDO_MEMORY)
+				drop_oldest_undo();
+		}
 	}
+	else
+		memcpy(undo_base, code, undo_size);
+	undo_valid = 1;
 
-	memcpy(undo[1], code, undo_size);
 	for (i = 0; i < 8; i++)
 	{
-		undo_regs[1][i] = dreg[i];
-		undo_regs[1][8 + i] = areg[i];
+		undo_base_regs[i] = dreg[i];
+		undo_base_regs[8 + i] = areg[i];
 	}
-	undo_regs[1][16] = i_count;
-	undo_regs[1][17] = pc;	/* status flags intentionally omitted */
-
-	undo_stat[0] = undo_stat[1];
-	undo_stat[1] = 1;
+	undo_base_regs[16] = i_count;
+	undo_base_regs[17] = pc;	/* status flags intentionally omitted */
 }
 
 type8 ms_undo(void)
 {
+	struct undo_turn *turn;
 	type8 i;
 
 	ms_flush();
-	if (!undo_stat[0])
+	if (!undo_count)
 		return 0;
 
-	undo_stat[0] = undo_stat[1] = 0;
-	memcpy(code, undo[0], undo_size);
+	undo_count--;
+	turn = &undo_ring[(undo_first + undo_count) % UNDO_DEPTH];
+	decode_undo(turn->diff, turn->diff_size);
+	free(turn->diff);
+	undo_memory -= turn->diff_size;
+	memcpy(undo_base_regs, turn->regs, sizeof(undo_base_regs));
+
+	memcpy(code, undo_base, undo_size);
 	for (i = 0; i < 8; i++)
 	{
-		dreg[i] = undo_regs[0][i];
-		areg[i] = undo_regs[0][8 + i];
+		dreg[i] = undo_base_regs[i];
+		areg[i] = undo_base_regs[8 + i];
 	}
-	i_count = undo_regs[0][16];
-	pc = undo_regs[0][17];	/* status flags intentionally omitted */
+	i_count = undo_base_regs[16];
+	pc = undo_base_regs[17];	/* status flags intentionally omitted */
+	undo_skip = 1;
 	return 1;
 }
 
@@ -2869,6 +3018,7 @@ void do_line_a(void)
 	if ((byte2 < 0xdd) || (version < 4 && byte2 < 0xe4) || (version < 2 && byte2 < 0xed))
 	{
 		ms_flush();	/* flush output-buffer */
+		slice_end = 1;	/* end ms_runslice() after this input */
 		rand_emu();	/* Increase game randomness */
 		l1c = ms_getchar(1);	/* 0 means UNDO */
 		if (l1c == 1)
@@ -2964,6 +3114,7 @@ void do_line_a(void)
 
 		case 4:	/* A0E1 Read from keyboard to (A1), status in D1 (0 for ok) */
 			ms_flush();
+			slice_end = 1;
 			rand_emu();
 			tmp32 = read_reg(8 + 1, 2);
 			str = (type8s*)effective(tmp32);
@@ -4330,3 +4481,13 @@ type8 ms_rungame(void)
 #endif
 	return running;
 }
+
+/* emulate up to budget instructions, stopping early after input */
+
+type8 ms_runslice(type32 budget)
+{
+	slice_end = 0;
+	while (running && !slice_end && budget-- > 0)
+		ms_rungame();
+	return running;
+}
@@ -109,6 +109,9 @@ static int gms_animation_enabled = TRUE,
 /* Magnetic Scrolls standard input prompt string. */
 static const char * const GMS_INPUT_PROMPT = ">";
 
+/* Maximum count of game opcodes run between calls to glk_tick(). */
+static const type32 GMS_SLICE_BUDGET = 10000;
+
 /* Forward declaration of event wait function. */
 static void gms_event_wait (glui32 wait_type, event_t * event);
 
@@ -6135,10 +6138,13 @@ gms_main (void)
       gms_graphics_possible = FALSE;
     }
 
-  /* Run the game opcodes -- ms_rungame() returns FALSE on game end. */
+  /*
+   * Run the game opcodes in slices -- ms_runslice() returns FALSE on game
+   * end.  Glk only needs ticking between slices, not every instruction.
+   */
   do
     {
-      is_running = ms_rungame ();
+      is_running = ms_runslice (GMS_SLICE_BUDGET);
       glk_tick ();
     }
   while (is_running);
@@ -301,6 +301,13 @@ static sc_ptshortword_t uip_word_pool[UIP_WORD_POOL_SIZE];
 static sc_int uip_word_pool_cursor = 0;
 static sc_int uip_word_pool_available = UIP_WORD_POOL_SIZE;
 
+/*
+ * Set while parsing a pattern tree for the pattern cache.  Cached trees live
+ * until the cache is destroyed, so their nodes and words come from straight
+ * malloc(), leaving the pools free for the temporary nodes used in matching.
+ */
+static sc_bool uip_parse_unpooled = FALSE;
+
 /*
  * uip_parse_match()
  *
@@ -338,7 +345,8 @@ uip_new_word (const sc_char *word)
    * until an unused slot is found, or until the index wraps to the cursor.
    */
   required = strlen (word) + 1;
-  if (uip_word_pool_available > 0 && required <= UIP_SHORT_WORD_SIZE)
+  if (!uip_parse_unpooled
+      && uip_word_pool_available > 0 && required <= UIP_SHORT_WORD_SIZE)
     {
       sc_int index_;
       sc_ptshortwordref_t shortword;
@@ -430,7 +438,7 @@ uip_new_node (sc_pttype_t type)
    * Unless the pool is empty, search forwards from the next cursor position
    * until an unused slot is found, or until the index wraps to the cursor.
    */
-  if (uip_node_pool_available > 0)
+  if (!uip_parse_unpooled && uip_node_pool_available > 0)
     {
       sc_int index_;
 
@@ -1762,19 +1770,82 @@ uip_debug_trace (sc_bool flag)
 
 
 /*
- * uip_match()
+ * Cache of parsed pattern trees, keyed by pattern string.  Every task command
+ * pattern is matched against every player input, so rather than tokenize and
+ * parse each pattern on every call, trees are parsed once and kept until the
+ * game is destroyed.  A NULL tree records a pattern that failed to parse.
  *
- * Match a string to a pattern, and return TRUE on match, FALSE otherwise.
- * For performance, this function uses a local buffer to try to avoid the
- * need to copy each of the pattern and match strings passed in.
+ * Each entry also notes the words that any input must begin with to match,
+ * if the pattern starts with a word or a [choice/of/words].  Most patterns
+ * do, so most matches can be rejected by comparing the first few characters
+ * of input, without walking the tree at all.
  */
-sc_bool
-uip_match (const sc_char *pattern, const sc_char *string, sc_gameref_t game)
+typedef struct sc_uip_cache_entry_s
+{
+  struct sc_uip_cache_entry_s *next;
+  sc_char *pattern;
+  sc_ptnoderef_t tree;
+  const sc_char **first_words;
+} sc_uip_cache_entry_t;
+typedef sc_uip_cache_entry_t *sc_uip_cache_entryref_t;
+enum { UIP_CACHE_BUCKETS = 4096, UIP_CACHE_LIMIT = 16384 };
+enum { UIP_MAX_FIRST_WORDS = 32 };
+static sc_uip_cache_entryref_t uip_cache[UIP_CACHE_BUCKETS];
+static sc_int uip_cache_count = 0;
+
+
+/*
+ * uip_collect_first_words()
+ *
+ * Add to words the words with which text matching the given list must begin,
+ * returning FALSE if the list can begin with anything else (or if there are
+ * too many words).  An empty list never matches, so it adds nothing.
+ */
+static sc_bool
+uip_collect_first_words (sc_ptnoderef_t list,
+                         const sc_char **words, sc_int *count)
+{
+  sc_ptnoderef_t first, child;
+
+  first = list->left_child;
+  if (!first)
+    return TRUE;
+
+  switch (first->type)
+    {
+    case NODE_WORD:
+      if (*count == UIP_MAX_FIRST_WORDS)
+        return FALSE;
+      words[(*count)++] = first->word;
+      return TRUE;
+
+    case NODE_CHOICE:
+      /* A choice matches only if one of its alternatives does. */
+      for (child = first->left_child; child; child = child->right_sibling)
+        {
+          if (!uip_collect_first_words (child, words, count))
+            return FALSE;
+        }
+      return TRUE;
+
+    default:
+      return FALSE;
+    }
+}
+
+
+/*
+ * uip_parse_pattern()
+ *
+ * Parse a pattern into a new tree, returning NULL if the pattern has syntax
+ * errors.
+ */
+static sc_ptnoderef_t
+uip_parse_pattern (const sc_char *pattern)
 {
   static sc_char *cleansed;  /* For setjmp safety. */
   sc_char buffer[UIP_ALLOCATION_AVOIDANCE_SIZE];
-  sc_bool match;
-  assert (pattern && string && game);
+  sc_ptnoderef_t tree;
 
   /* Start tokenizer. */
   cleansed = uip_cleanse_string (pattern, buffer, sizeof (buffer));
@@ -1799,25 +1870,168 @@ uip_match (const sc_char *pattern, const sc_char *string, sc_gameref_t game)
       uip_destroy_tree (uip_parse_tree);
       uip_parse_tree = NULL;
       cleansed = uip_free_cleansed_string (cleansed, buffer);
-      return FALSE;
+      return NULL;
+    }
+
+  tree = uip_parse_tree;
+  uip_parse_tree = NULL;
+  return tree;
+}
+
+
+/*
+ * uip_find_pattern()
+ *
+ * Return the cache entry for a pattern, parsing the pattern and adding it to
+ * the cache if not already there.  Returns NULL if the cache is full; the
+ * caller then needs to parse the pattern for itself.
+ */
+static sc_uip_cache_entryref_t
+uip_find_pattern (const sc_char *pattern)
+{
+  const sc_char *words[UIP_MAX_FIRST_WORDS];
+  sc_uip_cache_entryref_t entry;
+  sc_uint bucket;
+  sc_int count;
+
+  bucket = sc_hash (pattern) % UIP_CACHE_BUCKETS;
+  for (entry = uip_cache[bucket]; entry; entry = entry->next)
+    {
+      if (strcmp (entry->pattern, pattern) == 0)
+        return entry;
+    }
+
+  if (uip_cache_count == UIP_CACHE_LIMIT)
+    return NULL;
+
+  /* Parse the pattern, outside the node and word pools. */
+  entry = sc_malloc (sizeof (*entry));
+  entry->pattern = sc_malloc (strlen (pattern) + 1);
+  strcpy (entry->pattern, pattern);
+  uip_parse_unpooled = TRUE;
+  entry->tree = uip_parse_pattern (pattern);
+  uip_parse_unpooled = FALSE;
+
+  /* Note first words for the prefilter, if the pattern has them. */
+  entry->first_words = NULL;
+  count = 0;
+  if (entry->tree && uip_collect_first_words (entry->tree, words, &count))
+    {
+      entry->first_words = sc_malloc ((count + 1) * sizeof (*words));
+      memcpy (entry->first_words, words, count * sizeof (*words));
+      entry->first_words[count] = NULL;
     }
 
+  entry->next = uip_cache[bucket];
+  uip_cache[bucket] = entry;
+  uip_cache_count++;
+
+  return entry;
+}
+
+
+/*
+ * uip_could_match()
+ *
+ * Return FALSE if the string cannot begin with any of the cache entry's first
+ * words, so cannot match.  A word node matches if the string at that point
+ * begins with the word, ignoring case, which is all we need to check here.
+ */
+static sc_bool
+uip_could_match (sc_uip_cache_entryref_t entry, const sc_char *string)
+{
+  const sc_char **word;
+
+  if (!entry->first_words)
+    return TRUE;
+
+  for (word = entry->first_words; *word; word++)
+    {
+      if (sc_strncasecmp (string, *word, strlen (*word)) == 0)
+        return TRUE;
+    }
+
+  return FALSE;
+}
+
+
+/*
+ * uip_destroy_cache()
+ *
+ * Free all cached pattern trees.  Called when a game is destroyed.
+ */
+void
+uip_destroy_cache (void)
+{
+  sc_int bucket;
+
+  for (bucket = 0; bucket < UIP_CACHE_BUCKETS; bucket++)
+    {
+      sc_uip_cache_entryref_t entry, next;
+
+      for (entry = uip_cache[bucket]; entry; entry = next)
+        {
+          next = entry->next;
+          uip_destroy_tree (entry->tree);
+          sc_free (entry->first_words);
+          sc_free (entry->pattern);
+          sc_free (entry);
+        }
+      uip_cache[bucket] = NULL;
+    }
+  uip_cache_count = 0;
+}
+
+
+/*
+ * uip_match()
+ *
+ * Match a string to a pattern, and return TRUE on match, FALSE otherwise.
+ * For performance, this function uses a local buffer to try to avoid the
+ * need to copy the match string passed in, and takes the pattern's parse
+ * tree from the cache where possible.
+ */
+sc_bool
+uip_match (const sc_char *pattern, const sc_char *string, sc_gameref_t game)
+{
+  sc_char buffer[UIP_ALLOCATION_AVOIDANCE_SIZE];
+  sc_char *cleansed;
+  sc_uip_cache_entryref_t entry;
+  sc_ptnoderef_t tree;
+  sc_bool match;
+  assert (pattern && string && game);
+
+  /* Find the parsed pattern; if the cache is full, parse it just for now. */
+  entry = uip_find_pattern (pattern);
+  tree = entry ? entry->tree : uip_parse_pattern (pattern);
+  if (!tree)
+    return FALSE;
+
   /* Dump out the pattern tree if requested. */
   if (if_get_trace_flag (SC_DUMP_PARSER_TREES))
-    uip_debug_dump ();
+    {
+      uip_parse_tree = tree;
+      uip_debug_dump ();
+      uip_parse_tree = NULL;
+    }
 
-  /* Match the string to the pattern tree. */
+  /* Match the string to the pattern tree, if it passes the prefilter. */
   cleansed = uip_cleanse_string (string, buffer, sizeof (buffer));
   if (uip_trace)
     sc_trace ("UIParser: string \"%s\"\n", cleansed);
-  uip_match_start (cleansed, game);
-  match = uip_match_node (uip_parse_tree);
+  if (!entry || uip_could_match (entry, cleansed))
+    {
+      uip_match_start (cleansed, game);
+      match = uip_match_node (tree);
+      uip_match_end ();
+    }
+  else
+    match = FALSE;
 
-  /* Clean up matching and free the parsed pattern tree. */
-  uip_match_end ();
+  /* Clean up matching, and free the tree if it isn't cached. */
   cleansed = uip_free_cleansed_string (cleansed, buffer);
-  uip_destroy_tree (uip_parse_tree);
-  uip_parse_tree = NULL;
+  if (!entry)
+    uip_destroy_tree (tree);
 
   /* Return result of matching. */
   if (uip_trace)
@@ -36,7 +36,9 @@ static const sc_uint PROP_MAGIC = 0x7927b2e0;
 enum
 { PROP_GROW_INCREMENT = 32,
   MAX_INTEGER_KEY = 65535,
-  NODE_POOL_CAPACITY = 512
+  NODE_POOL_CAPACITY = 512,
+  KEY_CACHE_SIZE = 256,
+  CHILD_INDEX_INITIAL = 1024
 };
 static const sc_char NUL = '\0';
 
@@ -58,6 +60,27 @@ typedef struct sc_prop_node_s
 } sc_prop_node_t;
 typedef sc_prop_node_t *sc_prop_noderef_t;
 
+/*
+ * Lookup accelerators for readonly sets.  Once solidified, the tree shape
+ * and dictionary never change, so string keys can be resolved once to their
+ * dictionary address and matched by identity.  The key cache remembers the
+ * dictionary address for recently seen caller key pointers, and the child
+ * index maps (parent, dictionary name) pairs to the matching child node,
+ * including NULL for pairs known not to exist.
+ */
+typedef struct
+{
+  const sc_char *key;
+  const sc_char *interned;
+} sc_prop_key_cache_t;
+
+typedef struct
+{
+  sc_prop_noderef_t parent;
+  const sc_char *name;
+  sc_prop_noderef_t child;
+} sc_prop_child_entry_t;
+
 /*
  * Properties set structure.  This is a set of properties, on which the
  * properties functions operate (a properties "object").  Node string
@@ -77,6 +100,12 @@ typedef struct sc_prop_set_s
   sc_bool is_readonly;
   sc_prop_noderef_t root_node;
   sc_tafref_t taf;
+  sc_int intern_size;
+  const sc_char **intern_table;
+  sc_prop_key_cache_t key_cache[KEY_CACHE_SIZE];
+  sc_int child_index_size;
+  sc_int child_index_length;
+  sc_prop_child_entry_t *child_index;
 } sc_prop_set_t;
 
 
@@ -270,13 +299,147 @@ prop_new_node (sc_prop_setref_t bundle)
 }
 
 
+/*
+ * prop_intern_key()
+ *
+ * Return the dictionary address of a string key on a readonly set, or NULL
+ * if the string is not in the dictionary, in which case no node can have
+ * it as a name.  Caller key pointers are usually string literals or stable
+ * buffers, so a small cache on the pointer value avoids rehashing; a cache
+ * hit is still confirmed by string comparison, since buffers can be reused.
+ */
+static const sc_char *
+prop_intern_key (sc_prop_setref_t bundle, const sc_char *string)
+{
+  sc_prop_key_cache_t *entry;
+  sc_int mask, slot;
+
+  slot = ((sc_uint) (size_t) string >> 2) % KEY_CACHE_SIZE;
+  entry = bundle->key_cache + slot;
+  if (entry->key == string && strcmp (entry->interned, string) == 0)
+    return entry->interned;
+
+  /* Probe the interned strings hash table built on solidify. */
+  mask = bundle->intern_size - 1;
+  for (slot = sc_hash (string) & mask;
+       bundle->intern_table[slot]; slot = (slot + 1) & mask)
+    {
+      if (strcmp (bundle->intern_table[slot], string) == 0)
+        {
+          entry->key = string;
+          entry->interned = bundle->intern_table[slot];
+          return entry->interned;
+        }
+    }
+
+  return NULL;
+}
+
+
+/*
+ * prop_child_slot()
+ * prop_grow_child_index()
+ * prop_find_indexed_child()
+ *
+ * Find a string named child of the given parent on a readonly set, using
+ * the child index and filling it in on a miss.
+ */
+static sc_int
+prop_child_slot (sc_prop_setref_t bundle,
+                 sc_prop_noderef_t parent, const sc_char *name)
+{
+  sc_int mask, slot;
+
+  mask = bundle->child_index_size - 1;
+  slot = (((sc_uint) (size_t) parent >> 3) * 31
+          + ((sc_uint) (size_t) name >> 2)) & mask;
+  while (bundle->child_index[slot].parent
+         && !(bundle->child_index[slot].parent == parent
+              && bundle->child_index[slot].name == name))
+    slot = (slot + 1) & mask;
+
+  return slot;
+}
+
+static void
+prop_grow_child_index (sc_prop_setref_t bundle)
+{
+  sc_prop_child_entry_t *old_index;
+  sc_int old_size, index_;
+
+  old_index = bundle->child_index;
+  old_size = bundle->child_index_size;
+
+  /* Double the table, or create it on first use, and rehash entries. */
+  bundle->child_index_size = old_size > 0 ? old_size * 2 : CHILD_INDEX_INITIAL;
+  bundle->child_index = sc_malloc (bundle->child_index_size
+                                   * sizeof (*bundle->child_index));
+  memset (bundle->child_index, 0,
+          bundle->child_index_size * sizeof (*bundle->child_index));
+
+  for (index_ = 0; index_ < old_size; index_++)
+    {
+      if (old_index[index_].parent)
+        {
+          sc_int slot;
+
+          slot = prop_child_slot (bundle, old_index[index_].parent,
+                                  old_index[index_].name);
+          bundle->child_index[slot] = old_index[index_];
+        }
+    }
+
+  sc_free (old_index);
+}
+
+static sc_prop_noderef_t
+prop_find_indexed_child (sc_prop_setref_t bundle,
+                         sc_prop_noderef_t parent, const sc_char *name)
+{
+  const sc_char *interned;
+  sc_prop_noderef_t child;
+  sc_int slot, index_;
+
+  interned = prop_intern_key (bundle, name);
+  if (!interned)
+    return NULL;
+
+  /* Keep the index at most half full, then look for a cached result. */
+  if ((bundle->child_index_length + 1) * 2 > bundle->child_index_size)
+    prop_grow_child_index (bundle);
+
+  slot = prop_child_slot (bundle, parent, interned);
+  if (bundle->child_index[slot].parent)
+    return bundle->child_index[slot].child;
+
+  /* Not yet indexed, so scan children comparing names by address. */
+  child = NULL;
+  for (index_ = 0; index_ < parent->property.integer; index_++)
+    {
+      if (parent->child_list[index_]->name.string == interned)
+        {
+          child = parent->child_list[index_];
+          break;
+        }
+    }
+
+  bundle->child_index[slot].parent = parent;
+  bundle->child_index[slot].name = interned;
+  bundle->child_index[slot].child = child;
+  bundle->child_index_length++;
+
+  return child;
+}
+
+
 /*
  * prop_find_child()
  *
  * Find a child node of the given parent whose name matches that passed in.
  */
 static sc_prop_noderef_t
-prop_find_child (sc_prop_noderef_t parent, sc_int type, sc_vartype_t name)
+prop_find_child (sc_prop_noderef_t parent,
+                 sc_int type, sc_vartype_t name, sc_prop_setref_t bundle)
 {
   /* See if this node has any children. */
   if (parent->child_list)
@@ -309,6 +472,10 @@ prop_find_child (sc_prop_noderef_t parent, sc_int type, sc_vartype_t name)
           break;
 
         case PROP_KEY_STRING:
+          /* On readonly sets, use the child index instead of scanning. */
+          if (bundle->is_readonly)
+            return prop_find_indexed_child (bundle, parent, name.string);
+
           /* Scan children for a string name match. */
           for (index_ = 0; index_ < parent->property.integer; index_++)
             {
@@ -517,7 +684,7 @@ prop_put (sc_prop_setref_t bundle, const sc_char *format,
        * the set so that the dictionary can be extended.
        */
       type = format[index_ + 3];
-      child = prop_find_child (node, type, vt_key[index_]);
+      child = prop_find_child (node, type, vt_key[index_], bundle);
       if (child)
         node = child;
       else
@@ -603,7 +770,7 @@ prop_get (sc_prop_setref_t bundle, const sc_char *format,
 
       /* Move node down to the matching child, NULL if no match. */
       type = format[index_ + 3 ];
-      node = prop_find_child (node, type, vt_key[index_]);
+      node = prop_find_child (node, type, vt_key[index_], bundle);
       if (!node)
         break;
     }
@@ -696,6 +863,7 @@ prop_trim_node (sc_prop_noderef_t node)
 void
 prop_solidify (sc_prop_setref_t bundle)
 {
+  sc_int index_;
   assert (prop_is_valid (bundle));
 
   /*
@@ -716,6 +884,28 @@ prop_solidify (sc_prop_setref_t bundle)
                                         sizeof (bundle->orphans[0]));
   prop_trim_node (bundle->root_node);
 
+  /*
+   * Hash the dictionary strings into a table at most half full, so that
+   * string keys can be interned quickly on lookup once readonly.
+   */
+  bundle->intern_size = 16;
+  while (bundle->intern_size < bundle->dictionary_length * 2)
+    bundle->intern_size *= 2;
+  bundle->intern_table = sc_malloc (bundle->intern_size
+                                    * sizeof (*bundle->intern_table));
+  memset (bundle->intern_table, 0,
+          bundle->intern_size * sizeof (*bundle->intern_table));
+  for (index_ = 0; index_ < bundle->dictionary_length; index_++)
+    {
+      sc_int mask, slot;
+
+      mask = bundle->intern_size - 1;
+      for (slot = sc_hash (bundle->dictionary[index_]) & mask;
+           bundle->intern_table[slot]; slot = (slot + 1) & mask)
+        ;
+      bundle->intern_table[slot] = bundle->dictionary[index_];
+    }
+
   /* Set the bundle so that no more properties can be added. */
   bundle->is_readonly = TRUE;
 }
@@ -832,6 +1022,14 @@ prop_create_empty (void)
   /* No taf is yet connected with this set. */
   bundle->taf = NULL;
 
+  /* Lookup accelerators are built when the set is solidified. */
+  bundle->intern_size = 0;
+  bundle->intern_table = NULL;
+  memset (bundle->key_cache, 0, sizeof (bundle->key_cache));
+  bundle->child_index_size = 0;
+  bundle->child_index_length = 0;
+  bundle->child_index = NULL;
+
   return bundle;
 }
 
@@ -872,6 +1070,12 @@ prop_destroy (sc_prop_setref_t bundle)
   sc_free (bundle->dictionary);
   bundle->dictionary = NULL;
 
+  /* Free lookup accelerators. */
+  sc_free (bundle->intern_table);
+  bundle->intern_table = NULL;
+  sc_free (bundle->child_index);
+  bundle->child_index = NULL;
+
   /* Free adopted addresses. */
   for (index_ = 0; index_ < bundle->orphans_length; index_++)
     sc_free (bundle->orphans[index_]);
@@ -351,6 +351,7 @@ extern sc_bool uip_match (const sc_char *pattern,
 extern sc_char *uip_replace_pronouns (sc_gameref_t game, const sc_char *string);
 extern void uip_assign_pronouns (sc_gameref_t game, const sc_char *string);
 extern void uip_debug_trace (sc_bool flag);
+extern void uip_destroy_cache (void);
 
 /* Library perspective enumeration and functions. */
 enum
@@ -1786,6 +1786,9 @@ run_destroy (sc_gameref_t game)
   var_destroy (gs_get_vars (game));
   memo_destroy (gs_get_memento (game));
 
+  /* Drop the parsed task command patterns. */
+  uip_destroy_cache ();
+
   gs_destroy (game);
 }
 
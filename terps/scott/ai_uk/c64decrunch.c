@@ -636,6 +636,10 @@ static GameIDType DecrunchC64(uint8_t **sf, size_t *extent, struct c64rec record
 
     int result = 0;
 
+#ifdef GARGLK
+    unp64_set_cache_directory(garglk_decrunch_cache_directory());
+#endif
+
     for (int i = 1; i <= record.decompress_iterations; i++) {
         /* We only send switches on the iteration specified by parameter */
         if (i == record.parameter && record.switches != NULL) {
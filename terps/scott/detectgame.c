@@ -57,8 +57,15 @@ struct dictionaryKey dictKeys[] = {
 
 int FindCode(const char *x, int len)
 {
+    if (len <= 0 || file_length <= (size_t)len)
+        return -1;
     unsigned const char *p = entire_file;
-    while (p < entire_file + file_length - len) {
+    unsigned const char *end = entire_file + file_length - len;
+    while (p < end) {
+        /* Let memchr() skip ahead to the next possible first byte */
+        p = memchr(p, (unsigned char)x[0], end - p);
+        if (p == NULL)
+            break;
         if (memcmp(p, x, len) == 0) {
             return p - entire_file;
         }
@@ -67,11 +74,95 @@ int FindCode(const char *x, int len)
     return -1;
 }
 
+/*
+ * GetId() looks for all the dictionary signatures in a single pass over the
+ * file, using an Aho-Corasick automaton built from dictKeys[] on first use.
+ * Each state has a complete transition row, and a bit mask of the
+ * signatures that end in that state.
+ */
+
+#define MAX_SIGNATURE_STATES 128
+
+static int16_t signatureGoto[MAX_SIGNATURE_STATES][256];
+static unsigned signatureOutput[MAX_SIGNATURE_STATES];
+static int signatureStates = 0;
+
+static void BuildSignatureMatcher(void)
+{
+    int fail[MAX_SIGNATURE_STATES];
+    int queue[MAX_SIGNATURE_STATES];
+    int head = 0, tail = 0;
+
+    memset(signatureGoto, 0xff, sizeof(signatureGoto));
+    memset(signatureOutput, 0, sizeof(signatureOutput));
+    signatureStates = 1;
+
+    /* Build the trie of signatures */
+    for (int i = 0; dictKeys[i].dict != NOT_A_GAME; i++) {
+        int state = 0;
+        for (int j = 0; j < dictKeys[i].len; j++) {
+            uint8_t c = dictKeys[i].signature[j];
+            if (signatureGoto[state][c] < 0)
+                signatureGoto[state][c] = signatureStates++;
+            state = signatureGoto[state][c];
+        }
+        signatureOutput[state] |= 1u << i;
+    }
+
+    /* Fill in failure transitions breadth first */
+    for (int c = 0; c < 256; c++) {
+        int next = signatureGoto[0][c];
+        if (next < 0) {
+            signatureGoto[0][c] = 0;
+        } else {
+            fail[next] = 0;
+            queue[tail++] = next;
+        }
+    }
+    while (head < tail) {
+        int state = queue[head++];
+        signatureOutput[state] |= signatureOutput[fail[state]];
+        for (int c = 0; c < 256; c++) {
+            int next = signatureGoto[state][c];
+            if (next < 0) {
+                signatureGoto[state][c] = signatureGoto[fail[state]][c];
+            } else {
+                fail[next] = signatureGoto[fail[state]][c];
+                queue[tail++] = next;
+            }
+        }
+    }
+}
+
 DictionaryType GetId(size_t *offset)
 {
+    int first[sizeof(dictKeys) / sizeof(dictKeys[0])];
+    unsigned seen = 0;
+    int state = 0;
+
+    if (signatureStates == 0)
+        BuildSignatureMatcher();
+
+    /* Note the first position of each signature. Like FindCode(), ignore
+       matches that end on the last byte of the file. Signatures earlier in
+       dictKeys[] take priority, so stop once the first one is found. */
+    for (size_t i = 0; i + 1 < file_length; i++) {
+        state = signatureGoto[state][entire_file[i]];
+        unsigned out = signatureOutput[state] & ~seen;
+        if (out) {
+            for (int k = 0; dictKeys[k].dict != NOT_A_GAME; k++)
+                if (out & (1u << k))
+                    first[k] = (int)(i + 1) - dictKeys[k].len;
+            seen |= out;
+            if (seen & 1)
+                break;
+        }
+    }
+
+    *offset = -1;
     for (int i = 0; dictKeys[i].dict != NOT_A_GAME; i++) {
-        *offset = FindCode(dictKeys[i].signature, dictKeys[i].len);
-        if (*offset != -1) {
+        if (seen & (1u << i)) {
+            *offset = first[i];
             switch (dictKeys[i].dict) {
             case GERMAN_C64:
             case GERMAN:
@@ -1237,6 +1328,36 @@ uint8_t *DecompressParsec(uint8_t *start, uint8_t *end, uint8_t *dataptr)
     return dataptr;
 }
 
+/* Checks the header counts found relative to dict_start against those
+   listed for a game, without reading anything else. Entries that fail this
+   would be rejected by TryLoading() anyway, so we can skip them. */
+static int HeaderFingerprintMatches(const struct GameInfo *info, int dict_start)
+{
+    int h[15];
+    int ni, na, nw, nr, mc, pr, tr, wl, lt, mn, trm;
+
+    /* The UK Hulk releases don't have a header in this format */
+    if (info->gameID == HULK || info->gameID == HULK_C64)
+        return 1;
+
+    size_t offset = info->start_of_header + dict_start - info->start_of_dictionary;
+    uint8_t *ptr = SeekToPos(entire_file, offset);
+    if (ptr == NULL)
+        return 0;
+    /* Leave anything out of the ordinary to TryLoading() */
+    if (offset + 30 > file_length)
+        return 1;
+
+    for (int i = 0; i < 15; i++)
+        h[i] = ptr[i * 2] + 256 * ptr[i * 2 + 1];
+
+    if (!ParseHeader(h, info->header_style, &ni, &na, &nw, &nr, &mc, &pr,
+            &tr, &wl, &lt, &mn, &trm))
+        return 0;
+
+    return (ni == info->number_of_items && na == info->number_of_actions && nw == info->number_of_words && nr == info->number_of_rooms && mc == info->max_carried);
+}
+
 GameIDType DetectZXSpectrum(void)
 {
     GameIDType detectedGame = UNKNOWN_GAME;
@@ -1257,7 +1378,7 @@ GameIDType DetectZXSpectrum(void)
         return UNKNOWN_GAME;
 
     for (int i = 0; games[i].Title != NULL; i++) {
-        if (games[i].dictionary == dict_type) {
+        if (games[i].dictionary == dict_type && HeaderFingerprintMatches(&games[i], offset)) {
             detectedGame = TryLoading(games[i], offset, 0);
             if (detectedGame != UNKNOWN_GAME) {
                 free(Game);
@@ -330,6 +330,10 @@ int osfmode( const char* fname, int follow_links, unsigned long* mode,
  */
 #define OS_DEFAULT_SWAP_ENABLED 0
 
+/* Load the whole game into the cache at startup, so that the cache
+ * manager can run in resident mode. */
+#define OS_DEFAULT_PRELOAD 1
+
 /* TADS 2 macro/function configuration.  Modern configurations always
  * use the no-macro versions, so these definitions should always be set
  * as shown below. */
@@ -437,6 +441,16 @@ osfoprwb( const char* fname, os_filetype_t typ );
 /* Close a file. */
 #define osfcls fclose
 
+/* Map an entire file read-only into memory, returning a pointer to the
+ * mapped contents and setting *len to the file size.  Returns null if
+ * the file can't be mapped; the caller must then read it normally. */
+const char*
+os_map_file( const char* fname, unsigned long* len );
+
+/* Release a mapping obtained with os_map_file(). */
+void
+os_unmap_file( const char* mem, unsigned long len );
+
 /* Delete a file. */
 #define osfdel remove
 
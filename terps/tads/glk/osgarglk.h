@@ -82,6 +82,9 @@ void os_put_buffer (unsigned char *buf, size_t len);
 void os_get_buffer (unsigned char *buf, size_t len, size_t init);
 unsigned char *os_fill_buffer (unsigned char *buf, size_t len);
 
+/* register a function to do work in slices while waiting for line input */
+void os_set_idle_func (int (*func)(int finish));
+
 #define OS_MAXWIDTH 255
 
 #define OS_ATTR_HILITE  OS_ATTR_BOLD
@@ -553,6 +553,60 @@ int os_askfile(const char *prompt, char *fname_buf, int fname_buf_len,
     return OS_AFE_SUCCESS;
 }
 
+/*
+ *   Idle-time work.  The VM can register a function to be called in slices
+ *   while we wait for a line of input, driven by Glk timer events.  The
+ *   function is called with finish == FALSE to do one slice of work, and
+ *   returns true if it has more to do.  Before we return the input to the
+ *   VM, we call it with finish == TRUE to complete any work in progress.
+ *   Idle work is only done when we're not using the timer for anything
+ *   else.
+ */
+#define OS_IDLE_INTERVAL 10
+
+static int (*idle_func)(int finish) = NULL;
+static int idle_active = 0;
+
+void os_set_idle_func(int (*func)(int finish))
+{
+    idle_func = func;
+}
+
+static void os_idle_begin(void)
+{
+#ifdef GLK_TIMERS
+    if (idle_func)
+    {
+        idle_active = 1;
+        glk_request_timer_events(OS_IDLE_INTERVAL);
+    }
+#endif
+}
+
+static void os_idle_timer(void)
+{
+#ifdef GLK_TIMERS
+    if (idle_active && !idle_func(FALSE))
+    {
+        glk_request_timer_events(0);
+        idle_active = 0;
+    }
+#endif
+}
+
+static void os_idle_end(void)
+{
+#ifdef GLK_TIMERS
+    if (idle_active)
+    {
+        glk_request_timer_events(0);
+        idle_active = 0;
+    }
+#endif
+    if (idle_func)
+        idle_func(TRUE);
+}
+
 /* 
  *   Read a string of input.  Fills in the buffer with a null-terminated
  *   string containing a line of text read from the standard input.  The
@@ -565,15 +619,20 @@ unsigned char *os_gets(unsigned char *buf, size_t buflen)
     event_t event;
 
     os_get_buffer(buf, buflen, 0);
+    os_idle_begin();
 
     do
     {
         glk_select(&event);
         if (event.type == evtype_Arrange)
             redraw_windows();
+        else if (event.type == evtype_Timer)
+            os_idle_timer();
     }
     while (event.type != evtype_LineInput);
 
+    os_idle_end();
+
     return os_fill_buffer(buf, event.val1);
 }
 
@@ -674,12 +733,14 @@ int os_gets_timeout(unsigned char *buf, size_t bufl,
         timebuf = 0;
     }
 
-    /* start timer and turn off line echo */
+    /* start timer and turn off line echo, or do idle work if untimed */
     if (timer)
     {
         glk_request_timer_events(timer);
         glk_set_echo_line_event(mainwin, 0);
     }
+    else
+        os_idle_begin();
 
     os_get_buffer(buf, bufl, initlen);
 
@@ -688,11 +749,16 @@ int os_gets_timeout(unsigned char *buf, size_t bufl,
         glk_select(&event);
         if (event.type == evtype_Arrange)
             redraw_windows();
+        else if (event.type == evtype_Timer && !timer)
+            os_idle_timer();
         else if (event.type == evtype_Timer && (timeout = 1))
             glk_cancel_line_event(mainwin, &event);
     }
     while (event.type != evtype_LineInput);
 
+    if (!timer)
+        os_idle_end();
+
     unsigned char *res = os_fill_buffer(buf, event.val1);
 
     /* stop timer and turn on line echo */
@@ -50,6 +50,7 @@
 #include <time.h>
 #ifndef _WIN32
 #include <dirent.h>
+#include <sys/mman.h>
 #endif
 #include <limits.h>
 
@@ -387,6 +388,55 @@ os_exeseek( const char*, const char* )
 }
 
 
+/* Map a file read-only into memory.
+ *
+ * The mapping is private and never written through, so the interpreter
+ * can point directly into it for data it doesn't need to modify.  Returns
+ * null if the file can't be mapped, in which case the caller should read
+ * the file the ordinary way.
+ */
+const char*
+os_map_file( const char* fname, unsigned long* len )
+{
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0
+        || static_cast<unsigned long long>(st.st_size) > ULONG_MAX) {
+        close(fd);
+        return 0;
+    }
+
+    void* mem = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping holds its own reference to the file.
+    close(fd);
+    if (mem == MAP_FAILED)
+        return 0;
+
+    *len = static_cast<unsigned long>(st.st_size);
+    return static_cast<const char*>(mem);
+#else
+    return 0;
+#endif
+}
+
+
+/* Release a mapping obtained from os_map_file().
+ */
+void
+os_unmap_file( const char* mem, unsigned long len )
+{
+#ifndef _WIN32
+    if (mem != 0)
+        munmap(const_cast<char*>(mem), len);
+#endif
+}
+
+
 #if 0
 /* Create and open a temporary file.
  */
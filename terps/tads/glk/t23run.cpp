@@ -39,6 +39,8 @@
 #include "vmvsn.h"
 #include "vmmaincn.h"
 #include "vmhostsi.h"
+#include "vmglob.h"
+#include "vmobj.h"
 
 /* ------------------------------------------------------------------------ */
 
@@ -99,13 +101,57 @@ static int main_t2(int argc, char **argv)
     return stat;
 }
 
+/* ------------------------------------------------------------------------ */
+/*
+ *   T3 client interface.  While the program is running, we register an
+ *   idle function with the OS layer so that garbage collection can run in
+ *   slices while we wait for the player to enter a command, instead of
+ *   stopping the world in the middle of command processing.
+ */
+static struct vm_globals *idle_vmg = 0;
+
+static int t3_idle(int finish)
+{
+    VMGLOB_PTR(idle_vmg);
+
+    if (finish)
+    {
+        G_obj_table->gc_idle_finish(vmg0_);
+        return FALSE;
+    }
+
+    return G_obj_table->gc_idle_step(vmg0_);
+}
+
+class CVmMainClientGlk: public CVmMainClientConsole
+{
+public:
+    void pre_exec(struct vm_globals *vmg)
+    {
+        idle_vmg = vmg;
+        os_set_idle_func(t3_idle);
+    }
+
+    void post_exec(struct vm_globals *)
+    {
+        os_set_idle_func(0);
+        idle_vmg = 0;
+    }
+
+    void post_exec_err(struct vm_globals *)
+    {
+        os_set_idle_func(0);
+        idle_vmg = 0;
+    }
+};
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Invoke the T3 VM with the given command-line arguments
  */
 static int main_t3(int argc, char **argv)
 {
-    CVmMainClientConsole clientifc;
+    CVmMainClientGlk clientifc;
     int stat;
     CVmHostIfc *hostifc = new CVmHostIfcStdio(argv[0]);
 
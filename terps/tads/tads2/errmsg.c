@@ -429,7 +429,11 @@ use with your version of the debugger)" },
        "  -tf file      use file for swapping (default: TADSSWAP.DAT)" },
     { ERR_TRUS1 + 14,
        "  -ts size      maximum swapfile size (default: unlimited)" },
+#if OS_DEFAULT_PRELOAD
+    { ERR_TRUS1 + 15, "  -tp           (+)[toggle] preload all objects" },
+#else
     { ERR_TRUS1 + 15, "  -tp           (-)[toggle] preload all objects" },
+#endif
   { ERR_TRUS1 + 16,
 #if OS_DEFAULT_SWAP_ENABLED
                      "  -t-           disable swapping (enabled by default)" },
@@ -197,6 +197,7 @@ mcmcx1def *mcmini(ulong max, uint pages, ulong swapsize,
     ctx->mcmcxpgmx = pages;          /* max number of pages we can allocate */
     ctx->mcmcxerr = errctx;
     ctx->mcmcxcsw = mcmcswf;
+    ctx->mcmcxres = FALSE;                /* not resident unless asked to be */
     
     /* set up the free list with the remainder of the chunk */
     ctx->mcmcxfre = 1;     /* we've allocated object 0; obj 1 is free space */
@@ -839,6 +840,7 @@ void mcmuse(mcmcx1def *ctx, mcmon obj)
     
     MCMGLBCTX(ctx);
 
+    if (ctx->mcmcxres) return;          /* resident objects aren't tracked */
     if (ctx->mcmcxmru == obj) return;         /* already MRU; nothing to do */
     
     /* remove from LRU chain if it's in it */
@@ -1127,7 +1129,8 @@ void mcmunlck(mcmcxdef *ctx, mcmon obj)
         if (!(--(o->mcmolcnt)))
         {
             o->mcmoflg &= ~MCMOFLOCK;
-            mcmuse(ctx->mcmcxgl, mcmc2g(ctx, obj));
+            if (!ctx->mcmcxgl->mcmcxres)
+                mcmuse(ctx->mcmcxgl, mcmc2g(ctx, obj));
         }
     }
 }
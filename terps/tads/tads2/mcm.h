@@ -121,6 +121,7 @@ struct mcmcx1def
     ushort     mcmcxpgmx;        /* maximum number of pages we can allocate */
     void     (*mcmcxcsw)(mcmcx1def *, mcmon, mcsseg, mcsseg);
                          /* change swap handle in object to new swap handle */
+    int        mcmcxres;        /* resident mode - no LRU or swap tracking */
 };
 
 /* CLIENT cache manager context: used by client to request mcm services */
@@ -171,6 +172,17 @@ struct mcmcxdef
  *   and is the most recently unlocked block.  
  */
 
+/*
+ *   RESIDENT MODE: when mcmcxres is set, the client has undertaken to
+ *   load every object up front (see the fio preload flag) and never to
+ *   swap anything out.  In this mode, unlocking an object skips the LRU
+ *   bookkeeping entirely, so locking and unlocking a present object come
+ *   down to adjusting its lock count and fetching its pointer.  Objects
+ *   are never placed in the LRU list, so the swapper never finds a
+ *   candidate; compaction still honors locks as usual.  Resident mode
+ *   must be selected (with mcmres) before any objects are loaded.  
+ */
+
 /*
  *   initialize the cache manager, returning a context for cache manager
  *   operations; a null pointer is returned if insufficient heap memory is
@@ -187,6 +199,10 @@ mcmcx1def *mcmini(ulong max, uint pages, ulong swapsize,
 /* terminate the cache manager - frees the structure and all cache memory */
 void mcmterm(mcmcx1def *ctx);
 
+/* select resident mode (see above) */
+/* void mcmres(mcmcx1def *ctx); */
+#define mcmres(ctx) ((ctx)->mcmcxres = TRUE)
+
 /* allocate a client context */
 mcmcxdef *mcmcini(mcmcx1def *globalctx, uint pages,
                   void (*loadfn)(void *, mclhd, uchar *, ushort),
@@ -240,7 +256,8 @@ void mcmunlck(mcmcxdef *ctx, mcmon objnum);
  ((mcmobje(ctx,obj)->mcmoflg & MCMOFLOCK) ? \
   (--(mcmobje(ctx,obj)->mcmolcnt) ? (void)0 : \
   ((mcmobje(ctx,obj)->mcmoflg&=(~MCMOFLOCK)), \
-    mcmuse((ctx)->mcmcxgl,mcmc2g(ctx,obj)))) : (void)0)
+   ((ctx)->mcmcxgl->mcmcxres ? (void)0 : \
+    mcmuse((ctx)->mcmcxgl,mcmc2g(ctx,obj))))) : (void)0)
 
 #endif /* MCM_NO_MACRO */
 
@@ -5122,6 +5122,17 @@ int os_get_sysinfo(int code, void *param, long *result);
 # define OS_DEFAULT_SWAP_ENABLED   1
 #endif
 
+/*
+ *   TADS 2 preload configuration.  Define OS_DEFAULT_PRELOAD to 1 to load
+ *   every object in the game file at startup by default.  When objects are
+ *   preloaded and swapping is off, the run-time keeps the cache resident,
+ *   which skips all of the cache manager's LRU bookkeeping.  If we haven't
+ *   defined a default yet, load objects on demand.  
+ */
+#ifndef OS_DEFAULT_PRELOAD
+# define OS_DEFAULT_PRELOAD   0
+#endif
+
 /*
  *   If the system "long description" (for the banner) isn't defined, make
  *   it the same as the platform ID string.  
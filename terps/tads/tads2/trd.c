@@ -214,7 +214,8 @@ static void trdmain1(errcxdef *ec, int argc, char *argv[],
     uchar     *myheap;
     extern osfildef *cmdfile;     /* hacky v1 qa interface - command log fp */
     extern osfildef *logfp;        /* hacky v1 qa interface - output log fp */
-    int        preload = FALSE;              /* TRUE => preload all objects */
+    int        preload = OS_DEFAULT_PRELOAD; /* TRUE => preload all objects */
+    int        resident;    /* TRUE => preloading, never swapping or tossing */
     ulong      totsize;
     extern voccxdef *main_voc_ctx;
     int        safety_read, safety_write;          /* file I/O safety level */
@@ -509,6 +510,15 @@ static void trdmain1(errcxdef *ec, int argc, char *argv[],
         if (swapname == 0) swapname = swapbuf;
         if (swapfp == 0) errsig(ec, ERR_OPSWAP);
     }
+
+    /* 
+     *   if we're preloading everything, never swapping, and not limiting
+     *   the cache size, nothing will ever need to be evicted (note this
+     *   before the ERRBEGIN, since swapena isn't safe to read after the
+     *   setjmp) 
+     */
+    resident = (preload && !(swapena && swapsize)
+                && cachelimit == 0xffffffff);
     
     /* load the character map */
     if (charmap_none)
@@ -524,6 +534,10 @@ static void trdmain1(errcxdef *ec, int argc, char *argv[],
                    objrevert, (void *)0);
     mctx->mcmcxrvc = mctx;
 
+    /* if nothing will ever be evicted, skip the LRU bookkeeping */
+    if (resident)
+        mcmres(globalctx);
+
     /* set up an undo context */
     if (undosiz)
         undoptr = objuini(mctx, undosiz, vocdundo, vocdusz, &vocctx);
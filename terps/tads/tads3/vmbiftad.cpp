@@ -64,7 +64,8 @@ CVmBifTADSGlobals::CVmBifTADSGlobals(VMG0_)
 {
     /* allocate our regular expression parser */
     rex_parser = new CRegexParser();
-    rex_searcher = new CRegexSearcherSimple(rex_parser);
+    rex_cache = new CRegexCache(rex_parser);
+    rex_searcher = new CRegexSearcherSimple(rex_parser, rex_cache);
 
     /* 
      *   Allocate a global variable to hold the most recent regular
@@ -104,8 +105,9 @@ CVmBifTADSGlobals::CVmBifTADSGlobals(VMG0_)
  */
 CVmBifTADSGlobals::~CVmBifTADSGlobals()
 {
-    /* delete our regular expression searcher and parser */
+    /* delete our regular expression searcher, cache and parser */
     delete rex_searcher;
+    delete rex_cache;
     delete rex_parser;
 
     /* 
@@ -123,6 +123,9 @@ public:
     class CRegexParser *rex_parser;
     class CRegexSearcherSimple *rex_searcher;
 
+    /* compiled pattern cache for regular expressions given as strings */
+    class CRegexCache *rex_cache;
+
     /* 
      *   global variable for the last regular expression search string (we
      *   need to hold onto this because we might need to extract group-match
@@ -71,6 +71,7 @@ struct re_replace_arg
     {
         s = 0;
         pat = 0;
+        pat_cache = 0;
         pat_str = 0;
         rpl_func.set_nil();
         match_valid = FALSE;
@@ -78,9 +79,9 @@ struct re_replace_arg
 
     ~re_replace_arg()
     {
-        /* if we created the pattern object, delete it */
-        if (pat != 0 && our_pat)
-            CRegexParser::free_pattern(pat);
+        /* if we got the pattern from the cache, release it */
+        if (pat != 0 && pat_cache != 0)
+            pat_cache->release(pat);
         if (s != 0)
             delete s;
     }
@@ -103,8 +104,8 @@ struct re_replace_arg
             pat = ((CVmObjPattern *)vm_objp(vmg_ patv->val.obj))
                   ->get_pattern(vmg0_);
 
-            /* we didn't create the pattern object */
-            our_pat = FALSE;
+            /* the pattern belongs to the object, not the cache */
+            pat_cache = 0;
         }
         else if ((str = patv->get_as_string(vmg0_)) != 0)
         {
@@ -114,17 +115,13 @@ struct re_replace_arg
                 /* create the searcher */
                 create_searcher(vmg0_);
 
-                /* we treat strings as regular expressions - compile it */
-                re_status_t stat;
-                stat = G_bif_tads_globals->rex_parser->compile_pattern(
-                    str + VMB_LEN, vmb_get_len(str), &pat);
-
-                /* if that failed, we don't have a pattern */
-                if (stat != RE_STATUS_SUCCESS)
-                    pat = 0;
-
-                /* make a note that we allocated the pattern */
-                our_pat = TRUE;
+                /* 
+                 *   we treat strings as regular expressions - get the
+                 *   compiled pattern from the cache (this yields null if
+                 *   the pattern is invalid) 
+                 */
+                pat_cache = G_bif_tads_globals->rex_cache;
+                pat = pat_cache->get(str + VMB_LEN, vmb_get_len(str));
             }
             else
             {
@@ -272,8 +269,11 @@ struct re_replace_arg
     /* our search string, or null if we're searching for a pattern */
     const char *pat_str;
 
-    /* Did we create the pattern?  If so, delete it on destruction. */
-    int our_pat;
+    /* 
+     *   the cache we got the pattern from, if it came from a string - we
+     *   release it back to the cache on destruction 
+     */
+    class CRegexCache *pat_cache;
 
     /* our replacement string, or null if it's a callback function */
     const char *rpl_str;
@@ -121,6 +121,9 @@ VM_GLOBALS_BEGIN
     /* TadsObject inheritance path analysis queue */
     VM_GLOBAL_PREOBJDEF(class CVmObjTadsInhQueue, tadsobj_queue)
 
+    /* TadsObject inherited property lookup cache */
+    VM_GLOBAL_PREOBJDEF(class CVmObjTadsPropCache, tadsobj_pcache)
+
     /* dynamic compiler */
     VM_GLOBAL_OBJDEF(class CVmDynamicCompiler, dyncomp)
 
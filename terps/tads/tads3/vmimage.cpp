@@ -3154,6 +3154,88 @@ const char *CVmImageFileMem::alloc_and_read(size_t len, uchar xor_mask,
     return ret;
 }
 
+#ifdef GARGOYLE
+/* ------------------------------------------------------------------------ */
+/*
+ *   Image file interface - mapped external file implementation 
+ */
+
+/*
+ *   Delete the image file.  As with the external file reader, this must
+ *   not happen until every object loaded from the image has been deleted,
+ *   since those objects can point directly into the mapping. 
+ */
+CVmImageFileMapped::~CVmImageFileMapped()
+{
+    /* release the mapping */
+    os_unmap_file(mem_, len_);
+}
+
+/*
+ *   check that a read stays within the mapped file 
+ */
+void CVmImageFileMapped::check_read(size_t len) const
+{
+    if (pos_ < 0 || (ulong)pos_ > len_ || len > len_ - (ulong)pos_)
+        err_throw(VMERR_READ_PAST_IMG_END);
+}
+
+/*
+ *   copy data to the caller's buffer 
+ */
+void CVmImageFileMapped::copy_data(char *buf, size_t len)
+{
+    /* make sure the data are within the file */
+    check_read(len);
+
+    /* copy data into the caller's buffer */
+    memcpy(buf, mem_ + pos_, len);
+
+    /* seek past the data */
+    pos_ += len;
+}
+
+/*
+ *   allocate memory for and read data 
+ */
+const char *CVmImageFileMapped::alloc_and_read(size_t len, uchar xor_mask,
+                                               ulong remaining_in_page)
+{
+    const char *ret;
+
+    /* make sure the data are within the file */
+    check_read(len);
+
+    if (xor_mask == 0)
+    {
+        /* the data can be used in place - point into the mapping */
+        ret = mem_ + pos_;
+    }
+    else
+    {
+        char *mem;
+
+        /* the data need unmasking, so make a private copy */
+        mem = alloc_mem(len, remaining_in_page);
+        if (mem == 0)
+            err_throw(VMERR_OUT_OF_MEMORY);
+
+        /* copy the data and apply the XOR mask */
+        memcpy(mem, mem_ + pos_, len);
+        CVmImagePool::apply_xor_mask(mem, len, xor_mask);
+
+        /* return the copy */
+        ret = mem;
+    }
+
+    /* seek past the data */
+    pos_ += len;
+
+    /* return the data */
+    return ret;
+}
+#endif /* GARGOYLE */
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Generic stream implementation for an image file block 
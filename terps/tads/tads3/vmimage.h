@@ -803,10 +803,11 @@ public:
     /* skip the given number of bytes */
     void skip_ahead(long len);
 
-private:
+protected:
     /* allocate memory for loading data */
     char *alloc_mem(size_t siz, ulong remaining_in_page);
-    
+
+private:
     /* the underlying file */
     class CVmFile *fp_;
 
@@ -940,5 +941,72 @@ private:
 };
 
 
+#ifdef GARGOYLE
+/* ------------------------------------------------------------------------ */
+/*
+ *   Image file interface - external disk file mapped into memory with
+ *   os_map_file().  Pool pages and other blocks stored without an XOR
+ *   mask are handed out as pointers directly into the mapping, so they
+ *   never occupy heap memory; masked blocks (the compiler normally masks
+ *   the constant pool) are copied out and unmasked via the external file
+ *   reader's suballocator.  We keep the underlying file open so that
+ *   dup() can still provide independent handles for resource streams.  
+ */
+class CVmImageFileMapped: public CVmImageFileExt
+{
+public:
+    /* take ownership of the mapping; the caller retains the file */
+    CVmImageFileMapped(class CVmFile *fp, const char *mem, ulong len)
+        : CVmImageFileExt(fp)
+    {
+        /* remember the mapping */
+        mem_ = mem;
+        len_ = len;
+
+        /* start at the beginning of the file */
+        pos_ = 0;
+    }
+
+    /* release the mapping */
+    ~CVmImageFileMapped();
+
+    /* copy data to the caller's buffer */
+    void copy_data(char *buf, size_t len);
+
+    /* allocate memory for and read data */
+    const char *alloc_and_read(size_t len, uchar xor_mask,
+                               ulong remaining_in_page);
+
+    /* 
+     *   do not allow writing to alloc_and_read blocks, since unmasked
+     *   blocks point directly into the read-only mapping 
+     */
+    virtual int allow_write_to_alloc() { return FALSE; }
+
+    /* seek to a new file position */
+    void seek(long pos) { pos_ = pos; }
+
+    /* get the current seek position */
+    long get_seek() const { return pos_; }
+
+    /* skip the given number of bytes */
+    void skip_ahead(long len) { pos_ += len; }
+
+private:
+    /* make sure a read of the given length stays within the mapping */
+    void check_read(size_t len) const;
+
+    /* the mapped file contents */
+    const char *mem_;
+
+    /* size in bytes of the mapping */
+    ulong len_;
+
+    /* current offset within the mapping */
+    long pos_;
+};
+#endif /* GARGOYLE */
+
+
 #endif /* VMIMAGE_H */
 
@@ -172,6 +172,21 @@ int vm_run_image(const vm_run_image_params *params)
         }
 
         /* create the loader */
+#ifdef GARGOYLE
+        /* 
+         *   for an ordinary file, try mapping it into memory, so that
+         *   unmasked blocks can be used in place without copying; fall
+         *   back on regular reads if the file can't be mapped 
+         */
+        if (!params->load_from_exe)
+        {
+            unsigned long map_len;
+            const char *map = os_map_file(G_os_gamename, &map_len);
+            if (map != 0)
+                imagefp = new CVmImageFileMapped(fp, map, map_len);
+        }
+        if (imagefp == 0)
+#endif
         imagefp = new CVmImageFileExt(fp);
         loader = new CVmImageLoader(imagefp, G_os_gamename, image_file_base);
 
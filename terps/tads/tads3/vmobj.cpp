@@ -73,7 +73,44 @@ struct
 
     void end_pass()
     {
-        t += os_get_sys_clock_ms() - t0;
+        long pause = os_get_sys_clock_ms() - t0;
+        t += pause;
+        if (pause > max_pause)
+            max_pause = pause;
+        end_counts();
+    }
+
+    void begin_idle_pass()
+    {
+        runs++;
+        idle_runs++;
+        pass_start_bytes = cur_bytes;
+        cur_freed = 0;
+    }
+
+    void end_idle_pass()
+    {
+        end_counts();
+    }
+
+    void begin_slice()
+    {
+        t0 = os_get_sys_clock_ms();
+    }
+
+    void end_slice(int at_input)
+    {
+        long pause = os_get_sys_clock_ms() - t0;
+        t += pause;
+        idle_slices++;
+        if (pause > max_slice)
+            max_slice = pause;
+        if (at_input && pause > max_finish)
+            max_finish = pause;
+    }
+
+    void end_counts()
+    {
         if (cur_freed > max_freed)
             max_freed = cur_freed;
         long garbage_bytes = pass_start_bytes - cur_bytes;
@@ -115,7 +152,12 @@ struct
                "  peak heap bytes:       %ld\n"
                "  peak garbage bytes:    %ld\n"
                "  total gc time (ms):    %ld\n"
-               "  average gc time (ms):  %ld\n",
+               "  average gc time (ms):  %ld\n"
+               "  idle-time runs:        %ld\n"
+               "  idle-time slices:      %ld\n"
+               "  max idle slice (ms):   %ld\n"
+               "  max finish at input (ms): %ld\n"
+               "  max full pause (ms):   %ld\n",
                runs,
                tot_freed,
                runs != 0 ? tot_freed/runs : 0,
@@ -123,7 +165,12 @@ struct
                max_bytes,
                max_garbage_bytes,
                t,
-               runs != 0 ? t/runs : 0);
+               runs != 0 ? t/runs : 0,
+               idle_runs,
+               idle_slices,
+               max_slice,
+               max_finish,
+               max_pause);
     }
 
     /* number of times the gc has run */
@@ -153,9 +200,20 @@ struct
     /* elapsed time in garbage collector */
     long t;
 
-    /* starting time in ticks of current run */
+    /* starting time in ticks of current run or idle slice */
     long t0;
 
+    /* number of passes run at idle time, and the slices they took */
+    long idle_runs;
+    long idle_slices;
+
+    /* longest idle slice, and longest finish of an idle pass at input */
+    long max_slice;
+    long max_finish;
+
+    /* longest stop-the-world pass */
+    long max_pause;
+
 } gc_stats;
 
 #else /* VMOBJ_GC_STATS */
@@ -1495,6 +1553,9 @@ void CVmObjTable::init(VMG0_)
     /* enable the garbage collector */
     gc_enabled_ = TRUE;
 
+    /* no idle-time collection is in progress */
+    gc_idle_pass_ = FALSE;
+
     /* there are no saved image data pointers yet */
     image_ptr_head_ = 0;
     image_ptr_tail_ = 0;
@@ -1988,6 +2049,67 @@ void CVmObjTable::gc_full(VMG0_)
     IF_GC_STATS(gc_stats.end_pass());
 }
 
+/*
+ *   Idle-time garbage collection - do one step of work.  Starts a new pass
+ *   if none is in progress and anything has been allocated since the last
+ *   pass.  Returns true if there's more work to do.  
+ */
+int CVmObjTable::gc_idle_step(VMG0_)
+{
+    int i;
+
+    /* if no pass is in progress, start one if there's anything to collect */
+    if (!gc_idle_pass_)
+    {
+        if (!gc_enabled_ || (allocs_since_gc_ == 0 && bytes_since_gc_ == 0))
+            return FALSE;
+
+        /* mark the root set, which is all we'll do on this step */
+        IF_GC_STATS(gc_stats.begin_idle_pass());
+        IF_GC_STATS(gc_stats.begin_slice());
+        gc_pass_init(vmg0_);
+        gc_idle_pass_ = TRUE;
+        IF_GC_STATS(gc_stats.end_slice(FALSE));
+
+        return TRUE;
+    }
+
+    IF_GC_STATS(gc_stats.begin_slice());
+
+    /* trace a few increments of the work queue */
+    for (i = 0 ; i < VM_GC_IDLE_INCREMENTS ; ++i)
+    {
+        if (!gc_pass_continue(vmg_ TRUE))
+        {
+            /* the work queue is empty - sweep up and end the pass */
+            gc_pass_finish(vmg0_);
+            gc_idle_pass_ = FALSE;
+            IF_GC_STATS(gc_stats.end_idle_pass());
+            break;
+        }
+    }
+
+    IF_GC_STATS(gc_stats.end_slice(FALSE));
+
+    /* there's more to do if the pass is still in progress */
+    return gc_idle_pass_;
+}
+
+/*
+ *   Idle-time garbage collection - finish any pass in progress 
+ */
+void CVmObjTable::gc_idle_finish(VMG0_)
+{
+    if (gc_idle_pass_)
+    {
+        IF_GC_STATS(gc_stats.begin_slice());
+        gc_pass_finish(vmg0_);
+        gc_idle_pass_ = FALSE;
+        IF_GC_STATS(gc_stats.end_slice(TRUE));
+        IF_GC_STATS(gc_stats.end_idle_pass());
+    }
+}
+
 /*
  *   Garbage collector - initialize.  Add all globally-reachable objects
  *   to the work queue. 
@@ -106,6 +106,12 @@ Modified
  */
 const int VM_GC_WORK_INCREMENT = 500;
 
+/*
+ *   Number of work increments to process on each idle-time garbage
+ *   collection step (see CVmObjTable::gc_idle_step()). 
+ */
+const int VM_GC_IDLE_INCREMENTS = 4;
+
 
 
 /* ------------------------------------------------------------------------ */
@@ -1859,6 +1865,19 @@ public:
     int  gc_pass_continue(VMG0_) { return gc_pass_continue(vmg_ TRUE); }
     void gc_pass_finish(VMG0_);
 
+    /*
+     *   Idle-time garbage collection.  The host can call gc_idle_step()
+     *   repeatedly while waiting for user input.  Each call does a small
+     *   amount of incremental collection work, starting a new pass if
+     *   anything has been allocated since the last pass, and returns true
+     *   if there's more work to do.  Since no other VM activity is allowed
+     *   while a pass is in progress, the host must call gc_idle_finish()
+     *   before returning control to the VM; this completes any pass that
+     *   gc_idle_step() left unfinished.  
+     */
+    int  gc_idle_step(VMG0_);
+    void gc_idle_finish(VMG0_);
+
     /*
      *   Run pending finalizers.  This can be run at any time other than
      *   during garbage collection (i.e., between gc_pass_init() and
@@ -2458,6 +2477,9 @@ private:
 
     /* garbage collection enabled */
     uint gc_enabled_ : 1;
+
+    /* an idle-time garbage collection pass is in progress */
+    uint gc_idle_pass_ : 1;
 };
 
 /* ------------------------------------------------------------------------ */
@@ -2625,6 +2625,142 @@ void CRegexParser::free_pattern(re_compiled_pattern *pattern)
     t3free(pattern);
 }
 
+/* ------------------------------------------------------------------------ */
+/*
+ *   Compiled pattern cache 
+ */
+
+CRegexCache::CRegexCache(CRegexParser *parser)
+{
+    /* remember our parser */
+    parser_ = parser;
+
+    /* start with all slots empty */
+    memset(entries_, 0, sizeof(entries_));
+
+    /* no activity yet */
+    clock_ = 0;
+    hits_ = misses_ = 0;
+}
+
+CRegexCache::~CRegexCache()
+{
+    /* free our cached patterns */
+    for (int i = 0 ; i < RE_CACHE_SIZE ; ++i)
+        clear_entry(&entries_[i]);
+}
+
+/*
+ *   hash a pattern string 
+ */
+unsigned int CRegexCache::hash(const char *str, size_t len)
+{
+    /* FNV-1a */
+    unsigned int h = 2166136261U;
+    for ( ; len != 0 ; ++str, --len)
+        h = (h ^ (unsigned char)*str) * 16777619U;
+
+    return h;
+}
+
+/*
+ *   empty out a cache slot 
+ */
+void CRegexCache::clear_entry(entry *e)
+{
+    if (e->pat != 0)
+        CRegexParser::free_pattern(e->pat);
+    if (e->str != 0)
+        t3free(e->str);
+
+    memset(e, 0, sizeof(*e));
+}
+
+/*
+ *   look up or compile a pattern 
+ */
+re_compiled_pattern *CRegexCache::get(const char *expr_str, size_t exprlen)
+{
+    unsigned int h = hash(expr_str, exprlen);
+    entry *victim = 0;
+    int i;
+
+    /* look for the pattern, noting the best eviction candidate as we go */
+    for (i = 0 ; i < RE_CACHE_SIZE ; ++i)
+    {
+        entry *e = &entries_[i];
+
+        if (e->pat == 0)
+        {
+            /* an empty slot is always the best candidate */
+            if (victim == 0 || victim->pat != 0)
+                victim = e;
+        }
+        else if (e->hash == h && e->len == exprlen
+                 && memcmp(e->str, expr_str, exprlen) == 0)
+        {
+            /* found it - pin it and mark it as recently used */
+            ++hits_;
+            ++e->pins;
+            e->stamp = ++clock_;
+            return e->pat;
+        }
+        else if (e->pins == 0
+                 && (victim == 0
+                     || (victim->pat != 0 && e->stamp < victim->stamp)))
+        {
+            /* the least recently used unpinned entry so far */
+            victim = e;
+        }
+    }
+
+    /* it's not cached - compile it */
+    ++misses_;
+    re_compiled_pattern *pat;
+    if (parser_->compile_pattern(expr_str, exprlen, &pat)
+        != RE_STATUS_SUCCESS)
+        return 0;
+
+    /* 
+     *   if everything is pinned, hand back an uncached pattern; release()
+     *   will free it since it won't find it in the cache 
+     */
+    if (victim == 0)
+        return pat;
+
+    /* replace the victim with the new pattern */
+    clear_entry(victim);
+    victim->str = (char *)t3malloc(exprlen != 0 ? exprlen : 1);
+    memcpy(victim->str, expr_str, exprlen);
+    victim->len = exprlen;
+    victim->hash = h;
+    victim->pat = pat;
+    victim->pins = 1;
+    victim->stamp = ++clock_;
+
+    /* return the pattern */
+    return pat;
+}
+
+/*
+ *   release a pattern obtained from get() 
+ */
+void CRegexCache::release(re_compiled_pattern *pattern)
+{
+    /* if it's in the cache, unpin it */
+    for (int i = 0 ; i < RE_CACHE_SIZE ; ++i)
+    {
+        if (entries_[i].pat == pattern)
+        {
+            --entries_[i].pins;
+            return;
+        }
+    }
+
+    /* it's a private pattern - free it */
+    CRegexParser::free_pattern(pattern);
+}
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Register delta list.
@@ -4278,6 +4414,40 @@ int CRegexSearcher::match_pattern(
                  regs, loop_vars);
 }
 
+/* ------------------------------------------------------------------------ */
+/*
+ *   Compile a pattern string for a one-off search or match 
+ */
+int CRegexSearcherSimple::compile_temp(
+    const char *patstr, size_t patlen, re_compiled_pattern_base *tmp,
+    re_compiled_pattern **cpat, const re_compiled_pattern_base **pat,
+    const re_tuple **tuples)
+{
+    if (cache_ != 0)
+    {
+        /* get the pattern from the cache */
+        if ((*cpat = cache_->get(patstr, patlen)) == 0)
+            return FALSE;
+
+        /* use the cached pattern's own tuple array */
+        *pat = *cpat;
+        *tuples = (*cpat)->tuples;
+    }
+    else
+    {
+        /* compile into the temporary, using the parser's tuple array */
+        *cpat = 0;
+        if (parser_->compile(patstr, patlen, tmp) != RE_STATUS_SUCCESS)
+            return FALSE;
+
+        *pat = tmp;
+        *tuples = parser_->tuple_arr_;
+    }
+
+    /* success */
+    return TRUE;
+}
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Compile an expression and check for a match.  Returns the length of the
@@ -4294,7 +4464,10 @@ int CRegexSearcherSimple::compile_and_match(
     const char *patstr, size_t patlen,
     const char *entirestr, const char *searchstr, size_t searchlen)
 {
-    re_compiled_pattern_base pat;
+    re_compiled_pattern_base tmp;
+    re_compiled_pattern *cpat;
+    const re_compiled_pattern_base *pat;
+    const re_tuple *tuples;
     short loop_vars[RE_LOOP_VARS_MAX];
 
     /* no groups yet */
@@ -4304,16 +4477,19 @@ int CRegexSearcherSimple::compile_and_match(
     clear_group_regs();
 
     /* compile the expression - return failure if we get an error */
-    if (parser_->compile(patstr, patlen, &pat) != RE_STATUS_SUCCESS)
+    if (!compile_temp(patstr, patlen, &tmp, &cpat, &pat, &tuples))
         return FALSE;
 
     /* remember the group count from the compiled pattern */
-    group_cnt_ = pat.group_cnt;
+    group_cnt_ = pat->group_cnt;
 
     /* match the string */
     int m = match(entirestr, searchlen + (searchstr - entirestr),
                   searchstr, searchlen,
-                  &pat, parser_->tuple_arr_, &pat.machine, regs_, loop_vars);
+                  pat, tuples, &pat->machine, regs_, loop_vars);
+
+    /* done with the pattern */
+    release_temp(cpat);
 
     /* save the match information on success */
     if (m >= 0)
@@ -4348,12 +4524,15 @@ int CRegexSearcherSimple::compile_and_search(
     clear_group_regs();
 
     /* compile the expression - return failure if we get an error */
-    re_compiled_pattern_base pat;
-    if (parser_->compile(patstr, patlen, &pat) != RE_STATUS_SUCCESS)
+    re_compiled_pattern_base tmp;
+    re_compiled_pattern *cpat;
+    const re_compiled_pattern_base *pat;
+    const re_tuple *tuples;
+    if (!compile_temp(patstr, patlen, &tmp, &cpat, &pat, &tuples))
         return -1;
 
     /* remember the group count from the compiled pattern */
-    group_cnt_ = pat.group_cnt;
+    group_cnt_ = pat->group_cnt;
 
     /* 
      *   search for the pattern in our copy of the string - use the copy so
@@ -4361,8 +4540,10 @@ int CRegexSearcherSimple::compile_and_search(
      *   the original string after we return 
      */
     int m = search(entirestr, searchstr, searchlen,
-                   &pat, parser_->tuple_arr_, &pat.machine,
-                   regs_, result_len);
+                   pat, tuples, &pat->machine, regs_, result_len);
+
+    /* done with the pattern */
+    release_temp(cpat);
 
     /* save the match information on success */
     if (m >= 0)
@@ -4390,12 +4571,15 @@ int CRegexSearcherSimple::compile_and_search_back(
     clear_group_regs();
 
     /* compile the expression - return failure if we get an error */
-    re_compiled_pattern_base pat;
-    if (parser_->compile(patstr, patlen, &pat) != RE_STATUS_SUCCESS)
+    re_compiled_pattern_base tmp;
+    re_compiled_pattern *cpat;
+    const re_compiled_pattern_base *pat;
+    const re_tuple *tuples;
+    if (!compile_temp(patstr, patlen, &tmp, &cpat, &pat, &tuples))
         return -1;
 
     /* remember the group count from the compiled pattern */
-    group_cnt_ = pat.group_cnt;
+    group_cnt_ = pat->group_cnt;
 
     /* 
      *   search for the pattern in our copy of the string - use the copy so
@@ -4403,8 +4587,10 @@ int CRegexSearcherSimple::compile_and_search_back(
      *   the original string after we return 
      */
     int m = search_back(entirestr, searchstr, searchlen,
-                        &pat, parser_->tuple_arr_, &pat.machine,
-                        regs_, result_len);
+                        pat, tuples, &pat->machine, regs_, result_len);
+
+    /* done with the pattern */
+    release_temp(cpat);
 
     /* save the match information on success */
     if (m >= 0)
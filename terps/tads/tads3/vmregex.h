@@ -556,6 +556,85 @@ protected:
     size_t range_buf_max_;
 };
 
+/* ------------------------------------------------------------------------ */
+/*
+ *   Compiled pattern cache.  The intrinsics that accept a regular
+ *   expression as an ordinary string (rexMatch, rexSearch, rexReplace and
+ *   friends) would otherwise recompile the string on every call, and games
+ *   tend to call these with the same literal patterns over and over.  This
+ *   keeps the most recently used compiled patterns, keyed by the pattern
+ *   text.  (Options such as <nocase> are part of the text, and the default
+ *   case sensitivity is applied by the searcher at match time, so the text
+ *   alone identifies the compiled pattern.)
+ *   
+ *   A pattern obtained with get() is pinned until the caller hands it back
+ *   with release(), so that a caller holding several patterns at once (as
+ *   rexReplace can with an array of patterns) never has one evicted out
+ *   from under it.  If every slot is pinned, get() returns a private
+ *   compiled pattern, which release() simply frees.  
+ */
+#define RE_CACHE_SIZE  32
+
+class CRegexCache
+{
+public:
+    CRegexCache(class CRegexParser *parser);
+    ~CRegexCache();
+
+    /*
+     *   Get the compiled pattern for the given expression string, compiling
+     *   it if it's not already in the cache.  Returns null if the
+     *   expression has a syntax error.  The pattern must be passed to
+     *   release() when the caller is done with it.  
+     */
+    re_compiled_pattern *get(const char *expr_str, size_t exprlen);
+
+    /* release a pattern obtained from get() */
+    void release(re_compiled_pattern *pattern);
+
+    /* statistics - lookups satisfied from the cache, and compilations */
+    unsigned long get_hits() const { return hits_; }
+    unsigned long get_misses() const { return misses_; }
+
+protected:
+    /* cache entry */
+    struct entry
+    {
+        /* pattern text (allocated), its byte length, and its hash */
+        char *str;
+        size_t len;
+        unsigned int hash;
+
+        /* the compiled pattern, or null if the slot is empty */
+        re_compiled_pattern *pat;
+
+        /* number of outstanding get() calls not yet released */
+        int pins;
+
+        /* last use stamp, for choosing the least recently used entry */
+        unsigned long stamp;
+    };
+
+    /* hash a pattern string */
+    static unsigned int hash(const char *str, size_t len);
+
+    /* empty out a slot */
+    static void clear_entry(entry *e);
+
+    /* the parser we use to compile new patterns */
+    class CRegexParser *parser_;
+
+    /* the cache slots */
+    entry entries_[RE_CACHE_SIZE];
+
+    /* use counter for the LRU stamps */
+    unsigned long clock_;
+
+    /* statistics */
+    unsigned long hits_;
+    unsigned long misses_;
+};
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Pattern recognizer state stack.  Each time we need to process a
@@ -1170,10 +1249,14 @@ protected:
 class CRegexSearcherSimple: public CRegexSearcher
 {
 public:
-    CRegexSearcherSimple(class CRegexParser *parser)
+    CRegexSearcherSimple(class CRegexParser *parser,
+                         class CRegexCache *cache = 0)
     {
         /* remember my parser */
         parser_ = parser;
+
+        /* remember the compiled pattern cache, if any */
+        cache_ = cache;
     }
 
     ~CRegexSearcherSimple()
@@ -1319,6 +1402,26 @@ public:
     }
 
 protected:
+    /*
+     *   Compile a pattern string for one of the compile_and_xxx methods,
+     *   taking it from the cache if we have one, otherwise compiling it
+     *   into *tmp.  Fills in *pat and *tuples with the compiled pattern,
+     *   and *cpat with the cached pattern to pass to release_temp() when
+     *   done.  Returns false if the pattern has a syntax error.  
+     */
+    int compile_temp(const char *patstr, size_t patlen,
+                     re_compiled_pattern_base *tmp,
+                     re_compiled_pattern **cpat,
+                     const re_compiled_pattern_base **pat,
+                     const re_tuple **tuples);
+
+    /* release a pattern obtained from compile_temp() */
+    void release_temp(re_compiled_pattern *cpat)
+    {
+        if (cpat != 0)
+            cache_->release(cpat);
+    }
+
     /* group registers */
     re_group_register regs_[RE_GROUP_REG_CNT];
 
@@ -1330,6 +1433,12 @@ protected:
 
     /* my regular expression parser */
     class CRegexParser *parser_;
+
+    /* 
+     *   compiled pattern cache for the compile_and_xxx methods, or null to
+     *   compile each pattern afresh 
+     */
+    class CRegexCache *cache_;
 };
 
 #endif /* VMREGEX_H */
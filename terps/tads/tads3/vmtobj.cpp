@@ -322,6 +322,11 @@ void CVmObjTads::class_init(VMG0_)
     VM_IFELSE_ALLOC_PRE_GLOBAL(
         G_tadsobj_queue = new CVmObjTadsInhQueue(),
         G_tadsobj_queue->init());
+
+    /* allocate the inherited property lookup cache */
+    VM_IFELSE_ALLOC_PRE_GLOBAL(
+        G_tadsobj_pcache = new CVmObjTadsPropCache(),
+        G_tadsobj_pcache->init());
 }
 
 /*
@@ -333,9 +338,23 @@ void CVmObjTads::class_term(VMG0_)
     VM_IF_ALLOC_PRE_GLOBAL(
         delete G_tadsobj_queue;
         G_tadsobj_queue = 0;
+
+        delete G_tadsobj_pcache;
+        G_tadsobj_pcache = 0;
     )
 }
 
+/*
+ *   Invalidate the inherited property lookup cache if the given object is
+ *   involved in any cached search 
+ */
+static inline void inval_pcache_for(VMG_ const vm_tadsobj_hdr *hdr,
+                                    unsigned short flags)
+{
+    if ((hdr->intern_obj_flags & flags) != 0)
+        G_tadsobj_pcache->inval();
+}
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Static creation methods 
@@ -643,6 +662,12 @@ void CVmObjTads::notify_delete(VMG_ int in_root_set)
     /* free our extension */
     if (ext_ != 0)
     {
+        /* 
+         *   if we're involved in any cached inherited lookups, drop them,
+         *   since our object ID is about to become available for reuse 
+         */
+        inval_pcache_for(vmg_ get_hdr(), VMTO_OBJ_PCACHE | VMTO_OBJ_PCKEY);
+
         /* tell the header to delete its memory */
         get_hdr()->free_mem();
 
@@ -796,6 +821,9 @@ void CVmObjTads::set_prop(VMG_ CVmUndo *undo, vm_obj_id_t self,
         /* allocate a new entry */
         entry = hdr->alloc_prop_entry(prop, val, 0);
 
+        /* this could change the result of cached inherited lookups */
+        inval_pcache_for(vmg_ hdr, VMTO_OBJ_PCACHE);
+
         /* 
          *   The old value didn't exist, so mark it emtpy, with an intval of
          *   zero.  The zero indicates that this is a newly created property
@@ -1226,6 +1254,82 @@ int CVmObjTads::search_for_prop_from(VMG_ uint prop,
     return curpos.find_prop(vmg_ prop, val, source_obj);
 }
 
+/* ------------------------------------------------------------------------ */
+/*
+ *   Search our superclasses for a property, via the inherited property
+ *   lookup cache. 
+ */
+int CVmObjTads::find_inh_prop(VMG_ vm_obj_id_t self, vm_prop_id_t prop,
+                              vm_val_t *val, vm_obj_id_t *source_obj)
+{
+    vm_tadsobj_hdr *hdr = get_hdr();
+    tadsobj_sc_search_ctx curpos(vmg_ self, this);
+
+    /* 
+     *   Figure the cache key.  With a single superclass, the rest of the
+     *   search is exactly a search starting at the superclass, so key on
+     *   that.  Otherwise the search follows our own inheritance path, so
+     *   key on our own ID - but only if 'self' really is our ID.  
+     */
+    vm_obj_id_t key;
+    if (hdr->sc_cnt == 1)
+        key = hdr->sc[0].id;
+    else if (vm_objp(vmg_ self) == this)
+        key = self;
+    else
+        return curpos.to_next(vmg0_)
+            && curpos.find_prop(vmg_ prop, val, source_obj);
+
+    /* check the cache */
+    CVmObjTadsPropCache *pc = G_tadsobj_pcache;
+    vm_tadsobj_pcache_entry *ce = pc->find(key, prop);
+    if (ce != 0)
+    {
+        /* if the search previously came up empty, it still would */
+        if (ce->source == VM_INVALID_OBJ)
+            return FALSE;
+
+        /* fetch the property from the defining object */
+        vm_tadsobj_prop *entry = ((CVmObjTads *)vm_objp(vmg_ ce->source))
+                                 ->get_hdr()->find_prop_entry(prop);
+        if (entry != 0)
+        {
+            *val = entry->val;
+            *source_obj = ce->source;
+            return TRUE;
+        }
+
+        /* it's gone from there - do the full search */
+    }
+
+    /* note if we're a key that's particular to this object */
+    if (key == self)
+        hdr->intern_obj_flags |= VMTO_OBJ_PCKEY;
+
+    /* search the path, marking each object as part of a cached search */
+    if (curpos.to_next(vmg0_))
+    {
+        do
+        {
+            curpos.curhdr->intern_obj_flags |= VMTO_OBJ_PCACHE;
+            vm_tadsobj_prop *entry = curpos.curhdr->find_prop_entry(prop);
+            if (entry != 0)
+            {
+                /* found it - cache and return the result */
+                pc->store(key, prop, curpos.cur);
+                *val = entry->val;
+                *source_obj = curpos.cur;
+                return TRUE;
+            }
+        }
+        while (curpos.to_next(vmg0_));
+    }
+
+    /* it's not defined anywhere along the path - cache the failure */
+    pc->store(key, prop, VM_INVALID_OBJ);
+    return FALSE;
+}
+
 /* ------------------------------------------------------------------------ */
 /*
  *   Get a property.  We first look in this object; if we can't find the
@@ -1235,12 +1339,19 @@ int CVmObjTads::get_prop(VMG_ vm_prop_id_t prop, vm_val_t *val,
                          vm_obj_id_t self, vm_obj_id_t *source_obj,
                          uint *argc)
 {
-    /* 
-     *   try finding the property in my own direct property list or a
-     *   superclass property list 
-     */
-    tadsobj_sc_search_ctx curpos(vmg_ self, this);
-    if (curpos.find_prop(vmg_ prop, val, source_obj))
+    /* try finding the property in my own direct property list */
+    vm_tadsobj_hdr *hdr = get_hdr();
+    vm_tadsobj_prop *entry = hdr->find_prop_entry(prop);
+    if (entry != 0)
+    {
+        *val = entry->val;
+        *source_obj = self;
+        return TRUE;
+    }
+
+    /* try inheriting it from a superclass property list */
+    if (hdr->sc_cnt != 0
+        && find_inh_prop(vmg_ self, prop, val, source_obj))
         return TRUE;
 
     /* 
@@ -1520,6 +1631,9 @@ void CVmObjTads::apply_undo(VMG_ CVmUndoRecord *rec)
                 {
                     /* unlink it */
                     *prv = entry->nxt;
+
+                    /* drop cached inherited lookups that might find it */
+                    inval_pcache_for(vmg_ hdr, VMTO_OBJ_PCACHE);
                     
                     /* return it to the free list */
                     hdr->prop_entry_free -= 1;
@@ -1730,9 +1844,10 @@ void CVmObjTads::restore_from_file(VMG_ vm_obj_id_t self,
 
     /* 
      *   invalidate any existing inheritance path, in case the superclass
-     *   list changed 
+     *   list changed, and likewise any cached inherited lookups 
      */
     hdr->inval_inh_path();
+    G_tadsobj_pcache->inval();
 
     /* read the modified properties */
     for (ushort i = 0 ; i < mod_count ; ++i)
@@ -1824,6 +1939,9 @@ void CVmObjTads::load_from_image(VMG_ vm_obj_id_t self,
     /* load the image file properties */
     load_image_props_and_scs(vmg_ ptr, siz);
 
+    /* forget any cached inherited lookups */
+    G_tadsobj_pcache->inval();
+
     /* request post-load initialization, to set up the superclass list */
     G_obj_table->request_post_load_init(self);
 }
@@ -1865,6 +1983,9 @@ void CVmObjTads::reload_from_image(VMG_ vm_obj_id_t self,
     /* we're now unmodified from the image file state */
     hdr->intern_obj_flags &= ~VMTO_OBJ_MOD;
 
+    /* forget any cached inherited lookups */
+    G_tadsobj_pcache->inval();
+
     /* request post-load initialization, to set up the superclass list */
     G_obj_table->request_post_load_init(self);
 }
@@ -2265,8 +2386,9 @@ void CVmObjTads::change_superclass_list(VMG_ const vm_val_t *lst, int cnt)
         hdr->sc[i].objp = (CVmObjTads *)vm_objp(vmg_ ele.val.obj);
     }
 
-    /* invalidate the cached inheritance path */
+    /* invalidate the cached inheritance path and inherited lookups */
     hdr->inval_inh_path();
+    G_tadsobj_pcache->inval();
 }
 
 /* ------------------------------------------------------------------------ */
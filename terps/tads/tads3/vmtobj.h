@@ -230,6 +230,20 @@ struct vm_tadsobj_prop
 /* modified - object has been modified since being loaded from image */
 #define VMTO_OBJ_MOD     0x0002
 
+/* 
+ *   inherited lookup cache - the object is on the search path of at least
+ *   one entry in the inherited property lookup cache, so adding or
+ *   removing its properties, or deleting it, must invalidate the cache 
+ */
+#define VMTO_OBJ_PCACHE  0x0004
+
+/* 
+ *   inherited lookup cache key - the object has multiple superclasses and
+ *   is the key of at least one cache entry, so deleting it (which frees
+ *   its ID for reuse) must invalidate the cache 
+ */
+#define VMTO_OBJ_PCKEY   0x0008
+
 
 /*
  *   Property entry flags 
@@ -559,6 +573,13 @@ protected:
                                     vm_obj_id_t *source_obj,
                                     vm_obj_id_t defining_obj);
 
+    /* 
+     *   Search our superclasses (but not this object itself) for a
+     *   property, using the inherited property lookup cache 
+     */
+    int find_inh_prop(VMG_ vm_obj_id_t self, vm_prop_id_t prop,
+                      vm_val_t *val, vm_obj_id_t *source_obj);
+
     /* load the image file properties and superclasses */
     void load_image_props_and_scs(VMG_ const char *ptr, size_t siz);
 
@@ -1074,6 +1095,107 @@ protected:
 };
 
 
+/* ------------------------------------------------------------------------ */
+/*
+ *   Inherited property lookup cache.  When a property isn't defined
+ *   directly in an object, get_prop() has to walk the object's inheritance
+ *   path probing each superclass's hash table.  With deep class trees this
+ *   is a large part of execution time, so we remember where each
+ *   (start, property) search ended up: the object that defines the
+ *   property, or VM_INVALID_OBJ if nothing in the path defines it.
+ *   
+ *   The 'start' key is the single superclass for the usual case of an
+ *   object with exactly one superclass, so all instances of a class share
+ *   entries; for an object with multiple superclasses, the key is the
+ *   object itself, since the search path is particular to the object.
+ *   
+ *   Rather than tracking dependencies per entry, every entry is stamped
+ *   with the current epoch, and anything that could change the result of a
+ *   cached search bumps the epoch, which invalidates everything at once:
+ *   adding or removing a property in an object involved in a cached
+ *   search, deleting such an object, changing any superclass list, and
+ *   loading or restoring objects.  A hit costs one probe of this table
+ *   plus one hash probe in the defining object; if the defining object no
+ *   longer has the property, the caller simply does the full search.  
+ */
+struct vm_tadsobj_pcache_entry
+{
+    /* the search starting point and property */
+    vm_obj_id_t key;
+    vm_prop_id_t prop;
+
+    /* the defining object, or VM_INVALID_OBJ if not found */
+    vm_obj_id_t source;
+
+    /* epoch in which the entry was stored */
+    ulong epoch;
+};
+
+/* number of entries in the cache (must be a power of 2) */
+const size_t VMTOBJ_PCACHE_SIZE = 4096;
+
+class CVmObjTadsPropCache
+{
+public:
+    CVmObjTadsPropCache()
+    {
+        init();
+    }
+
+    void init()
+    {
+        /* empty the table, and start at the first valid epoch */
+        memset(tab_, 0, sizeof(tab_));
+        epoch_ = 1;
+    }
+
+    /* 
+     *   find a valid entry for the given key and property; returns null if
+     *   there's no entry 
+     */
+    vm_tadsobj_pcache_entry *find(vm_obj_id_t key, vm_prop_id_t prop)
+    {
+        vm_tadsobj_pcache_entry *e = &tab_[hash(key, prop)];
+        return (e->epoch == epoch_ && e->key == key && e->prop == prop
+                ? e : 0);
+    }
+
+    /* store the result of a search */
+    void store(vm_obj_id_t key, vm_prop_id_t prop, vm_obj_id_t source)
+    {
+        vm_tadsobj_pcache_entry *e = &tab_[hash(key, prop)];
+        e->key = key;
+        e->prop = prop;
+        e->source = source;
+        e->epoch = epoch_;
+    }
+
+    /* invalidate all entries */
+    void inval()
+    {
+        /* 
+         *   bump the epoch; in the unlikely event that it wraps around, we
+         *   have to clear the table so that ancient entries don't come back
+         *   to life 
+         */
+        if (++epoch_ == 0)
+            init();
+    }
+
+protected:
+    /* figure the table slot for a key and property */
+    static size_t hash(vm_obj_id_t key, vm_prop_id_t prop)
+    {
+        ulong h = ((ulong)key * 0x9E3779B1UL) ^ ((ulong)prop * 0x85EBCA6BUL);
+        return (size_t)((h ^ (h >> 15)) & (VMTOBJ_PCACHE_SIZE - 1));
+    }
+
+    /* the cache table */
+    vm_tadsobj_pcache_entry tab_[VMTOBJ_PCACHE_SIZE];
+
+    /* current epoch */
+    ulong epoch_;
+};
 
 
 #endif /* VMTOBJ_H */
@@ -41,6 +41,7 @@ Follows original disclaimer
 
 #include <cstring>
 #include <cstdio>
+#include <string>
 
 #include "types.h"
 #include "globals.h"
@@ -722,8 +723,82 @@ int unp64cpp(uint8_t *compressed, size_t length, uint8_t *destinationBuffer, siz
 } // End of namespace Unp64
 
 
+/* Decrunched images are cached on disk, one file per input image and
+   settings, named after a hash of both. A cache file holds the result
+   code as four little-endian bytes, followed by the decrunched data. */
+
+static std::string g_cacheDirectory;
+
+void unp64_set_cache_directory(const char *directory) {
+	g_cacheDirectory = directory != nullptr ? directory : "";
+}
+
+static std::string cacheFileName(const uint8_t *compressed, size_t length, const char *settings) {
+	/* 64-bit FNV-1a */
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= compressed[i];
+		hash *= 0x100000001b3ULL;
+	}
+	/* Separate the image from the settings, and no settings from empty ones */
+	hash ^= settings != nullptr ? 0x100 : 0x200;
+	hash *= 0x100000001b3ULL;
+	if (settings != nullptr) {
+		for (const char *c = settings; *c != '\0'; c++) {
+			hash ^= (uint8_t)*c;
+			hash *= 0x100000001b3ULL;
+		}
+	}
+
+	char name[64];
+	snprintf(name, sizeof name, "%016llx-%zx.unp64", (unsigned long long)hash, length);
+	return g_cacheDirectory + "/" + name;
+}
+
+static int readCache(const std::string &filename, uint8_t *destinationBuffer, size_t *finalLength) {
+	FILE *fp = fopen(filename.c_str(), "rb");
+	if (fp == nullptr)
+		return 0;
+
+	uint8_t header[4];
+	int result = 0;
+	if (fread(header, 1, 4, fp) == 4) {
+		result = header[0] | header[1] << 8 | header[2] << 16 | header[3] << 24;
+		*finalLength = fread(destinationBuffer, 1, 0x10000, fp);
+		/* Anything past 64K, or a failed read, means the file is not ours */
+		if (ferror(fp) || fgetc(fp) != EOF || *finalLength == 0)
+			result = 0;
+	}
+	fclose(fp);
+	return result;
+}
+
+static void writeCache(const std::string &filename, int result, const uint8_t *data, size_t length) {
+	/* Write to a temporary file first so that a partial file is never read */
+	std::string tempname = filename + ".tmp";
+	FILE *fp = fopen(tempname.c_str(), "wb");
+	if (fp == nullptr)
+		return;
+
+	uint8_t header[4] = {
+		(uint8_t)result, (uint8_t)(result >> 8), (uint8_t)(result >> 16), (uint8_t)(result >> 24)
+	};
+	bool ok = fwrite(header, 1, 4, fp) == 4 && fwrite(data, 1, length, fp) == length;
+	ok = fclose(fp) == 0 && ok;
+	if (!ok || rename(tempname.c_str(), filename.c_str()) != 0)
+		remove(tempname.c_str());
+}
+
 int unp64(uint8_t *compressed, size_t length, uint8_t *destinationBuffer, size_t *finalLength, const char *settings) {
 
+	std::string cachename;
+	if (!g_cacheDirectory.empty()) {
+		cachename = cacheFileName(compressed, length, settings);
+		int cached = readCache(cachename, destinationBuffer, finalLength);
+		if (cached)
+			return cached;
+	}
+
 	Unp64::size_t scottlength = (Unp64::size_t)length;
 	Unp64::size_t scottfinallength;
 
@@ -738,5 +813,9 @@ int unp64(uint8_t *compressed, size_t length, uint8_t *destinationBuffer, size_t
 	delete g_globals;
 	g_globals = nullptr;
 
+	/* Only successful results are cached, and only if they fit the buffer */
+	if (result && !cachename.empty() && *finalLength > 0 && *finalLength <= 0x10000)
+		writeCache(cachename, result, destinationBuffer, *finalLength);
+
 	return result;
 }
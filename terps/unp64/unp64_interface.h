@@ -12,6 +12,9 @@ extern "C"
 
 extern int unp64(uint8_t *compressed, size_t length, uint8_t *destinationBuffer, size_t *finalLength, const char *settings);
 
+/* Directory in which unp64() caches its results, or NULL to disable caching */
+extern void unp64_set_cache_directory(const char *directory);
+
 #ifdef __cplusplus
 }
 #endif